@@ -0,0 +1,78 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Minimal micro benchmark runner for the native environment
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <new>
+#include "benchmark.h"
+
+static uint64_t allocationAmount = 0;
+
+void* operator new(size_t size) {
+    allocationAmount++;
+    void* result = malloc(size == 0 ? 1 : size);
+    if (result == 0) {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    free(pointer);
+}
+
+uint64_t Benchmark::getAllocationAmount() {
+    return allocationAmount;
+}
+
+void Benchmark::printHeader() {
+    printf("%-40s %12s %12s %14s\n", "benchmark", "operations", "ns/op", "allocs/op");
+}
+
+void Benchmark::run(const char* name, TOperation operation, uint32_t minMilliseconds) {
+    typedef std::chrono::steady_clock clock;
+    // Warm up caches and lazily initialized statics
+    operation();
+    uint64_t amount = 1;
+    for (;;) {
+        uint64_t allocationsBefore = allocationAmount;
+        clock::time_point start = clock::now();
+        for (uint64_t i = 0; i < amount; i++) {
+            operation();
+        }
+        clock::duration duration = clock::now() - start;
+        uint64_t allocations = allocationAmount - allocationsBefore;
+        uint64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        if (nanoseconds >= uint64_t(minMilliseconds) * 1000000 || amount >= (uint64_t(1) << 40)) {
+            printf("%-40s %12llu %12.1f %14.2f\n", name, (unsigned long long) amount, 
+                double(nanoseconds) / amount, double(allocations) / amount);
+            return;
+        }
+        amount *= 2;
+    }
+}
@@ -0,0 +1,47 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Minimal micro benchmark runner for the native environment. Measures wall clock time and heap
+ * allocations per operation.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+
+class Benchmark {
+public:
+    typedef std::function<void()> TOperation;
+
+    /**
+     * Runs an operation repeatedly and prints ns/op and allocations/op
+     * @param name name printed in the result table
+     * @param operation function executing one operation
+     * @param minMilliseconds minimal measurement time, the amount of operations is doubled until reached
+     */
+    static void run(const char* name, TOperation operation, uint32_t minMilliseconds = 200);
+
+    /**
+     * Prints the header of the result table
+     */
+    static void printHeader();
+
+    /**
+     * @returns amount of heap allocations by operator new since program start
+     */
+    static uint64_t getAllocationAmount();
+
+    /**
+     * Prevents the compiler from removing a result not used otherwise
+     */
+    template<class T>
+    static void doNotOptimize(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+};
@@ -0,0 +1,287 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Copy of the string copying JSON parser and tokenizer, unchanged apart from the class names
+ */
+
+#include "legacy_json.h"
+
+static String unquote(const String& quotedString) {
+    String result;
+    if (quotedString.charAt(0) == '"' && quotedString.charAt(quotedString.length() - 1) == '"') {
+		result = quotedString.substring(1, quotedString.length() - 1);
+	} else {
+        result = quotedString;
+    }
+    return result;
+}
+
+void LegacyJSONTokenizer::skipSpaces()
+{
+	while ((_data.charAt(_pos) == ' ') || (_data.charAt(_pos) == '\n'))
+		_pos++;
+}
+
+void LegacyJSONTokenizer::findChar(char searchCh, bool multiLine)
+{
+	while ((_data.charAt(_pos) != searchCh) && (_data.charAt(_pos) != 0))
+	{
+		if (!multiLine && (_data.charAt(_pos) == '\n'))
+			break;
+		_pos++;
+	}
+}
+
+
+void LegacyJSONTokenizer::skipSymbolContinuation()
+{
+	for (;; _pos++)
+	{
+		const char curCh = _data.charAt(_pos);
+		if (!(((curCh >= 'a') && (curCh <= 'z')) ||
+			((curCh >= '0') && (curCh <= '9')) ||
+			((curCh >= 'A') && (curCh <= 'Z')) ||
+			(curCh == '_') || (curCh == '+') ||
+			(curCh == '#') || (curCh == '=') ||
+			(curCh == ':') || (curCh == '-') || (curCh == '/')))
+			break;
+	}
+}
+
+String LegacyJSONTokenizer::getNextToken()
+{
+	if (_error != "") {
+		return "";
+	}
+	skipSpaces();
+	uint16_t tokenStartPos = _pos;
+	char curCh = _data.charAt(_pos);
+
+	switch (curCh)
+	{
+	case 0:
+		break;
+	case '[':
+	case ']':
+	case '{':
+	case '}':
+	case '(':
+	case ')':
+	case '<':
+	case '>':
+	case '.':
+	case '*':
+	case '!':
+	case '?':
+		// Special single char tokens
+		_pos++;
+		break;
+	case '"':
+		// Scan a string
+		_pos++;
+		findChar('"', false);
+		_pos++;
+		break;
+	default:
+		if (((curCh >= 'a') && (curCh <= 'z')) ||
+			((curCh >= '0') && (curCh <= '9')) ||
+			((curCh >= 'A') && (curCh <= 'Z')))
+		{
+			skipSymbolContinuation();
+		}
+		else
+			_pos++; // Unknown char
+	}
+	return _data.substring(tokenStartPos, _pos);
+}
+
+/**
+  * Gets the content of an array
+  * @param json string tokenizer
+  * @returns Array content
+  */
+String LegacyJSON::getArrayContent(LegacyJSONTokenizer& json) const {
+	String object = getNextObject(json);
+	String result = "";
+	String tk;
+	while (object != "" && object != "]") {
+		result += object;
+		tk = json.getNextToken();
+		if (tk == "") {
+			break;
+		}
+		else if (tk == ",") {
+			result += tk;
+			object = getNextObject(json);
+		}
+		else if (tk == "]") {
+			break;
+		} else {
+			json.setError(", or ]");
+		}
+	}
+	result += tk;
+	return result;
+}
+
+/**
+* Gets the content of an array
+* @param json string tokenizer
+* @returns Array content
+*/
+String LegacyJSON::getObjectContent(LegacyJSONTokenizer& json) const {
+	String propertyName = json.getNextToken();
+	String result = propertyName;
+	while (propertyName != "}" && propertyName != "") {
+		result += json.skipExpectedToken(":");
+		result += getNextObject(json);
+		String tk = json.getNextToken();
+		if (tk == "}") {
+			result += tk;
+			break;
+		}
+		else if (tk == ",") {
+			result += tk;
+			propertyName = json.getNextToken();
+			result += propertyName;
+		}
+		else {
+			json.setError(", or  }");
+		}
+	}
+	return result;
+}
+
+/**
+ * Gets the next object of a json
+ * @param json string tokenizer
+ */
+String LegacyJSON::getNextObject(LegacyJSONTokenizer& json) const {
+	String tk = json.getNextToken();
+	String result = tk;
+	if (tk == "{") {
+		result += getObjectContent(json);
+	}
+	else if (tk == "[") {
+		result += getArrayContent(json);
+	}
+	else if (tk == "]" || tk == "}") {
+		return tk;
+	} 
+	return result;
+}
+
+
+/**
+* Gets a property from a json object
+* @param json string tokenizer
+* @param property property name
+* @returns true, if found
+*/
+bool LegacyJSON::searchPropertyInObject(LegacyJSONTokenizer& json, const String& property) const {
+	String tk;
+	bool result = false;
+	json.skipExpectedToken("{");
+	tk = json.getNextToken();
+	while (tk != "}") {
+		json.skipExpectedToken(":");
+		if (tk == "\"" + property + "\"") {
+			result = true;
+			break;
+		}
+		getNextObject(json);
+		tk = json.getNextToken();
+		if (tk == ",") {
+			tk = json.getNextToken();
+		} else if (tk != "}") {
+			json.setError("} or ,");
+			break;
+		}
+	}
+	return result;
+}
+
+/**
+* Gets a property from a json object
+* @param json string tokenizer
+* @param property property name
+* @returns true, if found
+*/
+bool LegacyJSON::searchArrayElement(LegacyJSONTokenizer& json, uint16_t index) const {
+	json.skipExpectedToken("[");
+	String tk;
+	while (index > 0 && tk != "]") {
+		getNextObject(json);
+		tk = json.getNextToken();
+		if (tk == ",") {
+			index--;
+		} else if (tk != "]") {
+			json.setError("] or ,");
+			break;
+		} 
+	}
+	return index == 0;
+}
+
+
+/**
+* Recursively extracts a substring from a json string by following the path
+* @param json string in JSON format
+* @param path string in json path format
+*/
+String LegacyJSON::getElementRec(LegacyJSONTokenizer& json, LegacyJSONTokenizer& path) const {
+	String pathChunk = path.getNextToken();
+	String result = "";
+	if (pathChunk == ".") {
+		pathChunk = path.getNextToken();
+	}
+	if (pathChunk == "") {
+		result = getNextObject(json);
+	}
+	else if (pathChunk == "[") {
+		String indexString = path.getNextToken();
+		uint16_t index = indexString.toInt();
+		path.skipExpectedToken("]");
+		if (searchArrayElement(json, index)) {
+			result = getElementRec(json, path);
+		}
+	}
+	else {
+		if (searchPropertyInObject(json, pathChunk)) {
+			result = getElementRec(json, path);
+		}
+	}
+	return result;
+}
+
+String LegacyJSON::getElement(String jsonPath) const {
+	LegacyJSONTokenizer json(_jsonString);
+	LegacyJSONTokenizer path(jsonPath);
+	String result = unquote(getElementRec(json, path));
+	return result;
+}
+
+legacyJSONObject_t LegacyJSON::parseObject(String jsonPath) const {
+    legacyJSONObject_t result;
+    String subObject = getElement(jsonPath);
+    LegacyJSONTokenizer json(subObject);
+	json.skipExpectedToken("{");
+	String tk = json.getNextToken();
+	while (tk != "}") {
+		json.skipExpectedToken(":");
+		result[unquote(tk)] = unquote(getNextObject(json));
+		tk = json.getNextToken();
+		if (tk == ",") {
+		    tk = json.getNextToken();
+		} else if (tk != "}") {
+			json.setError("} or ,");
+			break;
+		}
+	}
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Copy of the string copying JSON parser and tokenizer the library used before the view based 
+ * JSON class. Kept in the benchmarks only, to compare both implementations on the same input.
+ */
+
+#pragma once
+
+#include <map>
+#include <Arduino.h>
+
+typedef std::map<String, String> legacyJSONObject_t;
+
+/**
+ * String based tokenizer, every token is returned as new String
+ */
+class LegacyJSONTokenizer
+{
+public:
+	LegacyJSONTokenizer(const String &data) : _data(data), _pos(0), _error("") {}
+
+	/**
+	* Gets the next token
+	*/
+	String getNextToken();
+
+	/**
+	* Skips an expected token or throws an error
+	* @param expectedToken token that is expected
+	*/
+	String skipExpectedToken(const String& expectedToken) {
+		String result = getNextToken();
+		if (result != expectedToken) {
+			setError(expectedToken);
+		}
+		return result;
+	}
+
+	/**
+	 * Sets an error condition
+	 * @param text expected value/situation
+	 */
+	void setError(const String& text) {
+		_error = String("Error at pos ") + String(_pos) + String(" expected: ") + text;
+	}
+
+private:
+	/**
+	* Skips all spaces and line breaks
+	*/
+	void skipSpaces();
+
+	/**
+	* Search a string until a special char is found or until line end (if multiLine is false)
+	* @param searchCh char to search for
+	* @param multiLine true, if the search should pass line ends
+	*/
+	void findChar(char searchCh, bool multiLine);
+
+	/**
+	* Skips all characters allowed in symbols
+	*/
+	void skipSymbolContinuation();
+
+	String _data;
+	uint16_t _pos;
+	String _error;
+};
+
+/**
+ * JSON path access by copying every visited value into Strings
+ */
+class LegacyJSON {
+public:
+	LegacyJSON(const String& jsonString) :_jsonString(jsonString) {}
+
+	/**
+	* Gets an element from the JSON fromatted string based on a json path
+	* @param jsonPath path of the for a.b[x] (as in javaScript)
+	*/
+	String getElement(String jsonPath) const;
+
+	/**
+	 * Parses an object in JSON notation {...} and returns it as map
+	 */
+	legacyJSONObject_t parseObject(String jsonPath) const;
+
+private:
+	String _jsonString;
+
+	String getArrayContent(LegacyJSONTokenizer& json) const;
+	String getObjectContent(LegacyJSONTokenizer& json) const;
+	String getNextObject(LegacyJSONTokenizer& json) const;
+	bool searchPropertyInObject(LegacyJSONTokenizer& json, const String& property) const;
+	bool searchArrayElement(LegacyJSONTokenizer& json, uint16_t index) const;
+	String getElementRec(LegacyJSONTokenizer& json, LegacyJSONTokenizer& path) const;
+};
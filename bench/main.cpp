@@ -0,0 +1,199 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Micro benchmarks of the hot paths, run with "pio run -e native -t exec"
+ */
+
+// The unit tests build the sources too and bring their own main
+#ifndef PIO_UNIT_TESTING
+
+#include <stdio.h>
+#include <Arduino.h>
+#include <json.h>
+#include <jsonwriter.h>
+#include <message.h>
+#include <properties.h>
+#include <formtemplate.h>
+#include <assets.h>
+#include <ESP8266WiFi.h>
+#include <loopback.h>
+#include <brokerproxy.h>
+#include "benchmark.h"
+#include "legacy_json.h"
+
+/**
+ * Output discarding everything written, counts the bytes only
+ */
+class NullPrint : public Print {
+public:
+    NullPrint() : _length(0) {}
+    virtual size_t write(uint8_t c) { _length++; return 1; }
+    virtual size_t write(const uint8_t* buffer, size_t size) { _length += size; return size; }
+    using Print::write;
+    size_t getLength() const { return _length; }
+private:
+    size_t _length;
+};
+
+static const char publishBody[] =
+    "{\"message\":{\"topic\":\"area/level/room/device/switch/D4/set\",\"value\":\"on\","
+    "\"reason\":[{\"timestamp\":\"2021-05-03T10:00:00\",\"message\":\"switched by rule\"}]},"
+    "\"qos\":1,\"retain\":false}";
+
+static const char configBody[] =
+    "{\"battery/mode\":\"on\",\"battery/lowVoltage\":\"3.10\",\"battery/highVoltage\":\"3.50\","
+    "\"battery/lowVoltageSleepTimeInSeconds\":3600,\"battery/normalVoltageSleepTimeInSeconds\":900,"
+    "\"battery/highVoltageSleepTimeInSeconds\":120,\"battery/voltageCalibrationDivisor\":\"24.00\"}";
+
+static void benchmarkJSON() {
+    String body(publishBody);
+    Benchmark::run("json/getElements (2 paths)", [&body]() {
+        JSON json(body);
+        const char* paths[] = { "message.topic", "message.value" };
+        JSONSpan spans[2];
+        Benchmark::doNotOptimize(json.getElements(paths, spans));
+    });
+    Benchmark::run("json/getElement to buffer", [&body]() {
+        JSON json(body);
+        char topic[64];
+        Benchmark::doNotOptimize(json.getElement("message.topic", topic, sizeof(topic)));
+    });
+    Benchmark::run("json/getElement to String", [&body]() {
+        JSON json(body);
+        Benchmark::doNotOptimize(json.getElement("message.topic"));
+    });
+    String config(configBody);
+    Benchmark::run("json/parseObject (7 properties)", [&config]() {
+        Benchmark::doNotOptimize(JSON(config).parseObject("").size());
+    });
+}
+
+/**
+ * Runs the string copying parser on the inputs of benchmarkJSON as baseline
+ */
+static void benchmarkLegacyJSON() {
+    String body(publishBody);
+    Benchmark::run("json legacy/getElement to String", [&body]() {
+        LegacyJSON json(body);
+        Benchmark::doNotOptimize(json.getElement("message.topic"));
+    });
+    String config(configBody);
+    Benchmark::run("json legacy/parseObject (7 properties)", [&config]() {
+        Benchmark::doNotOptimize(LegacyJSON(config).parseObject("").size());
+    });
+}
+
+static void benchmarkMessages() {
+    const Message message("area/level/room/device/sensor/temperature", "21.53", "send by ESP8266");
+    Benchmark::run("message/construct", []() {
+        Message created("area/level/room/device/sensor/temperature", String(21.53F), "send by ESP8266");
+        Benchmark::doNotOptimize(created);
+    });
+    Benchmark::run("message/toPublishString", [&message]() {
+        Benchmark::doNotOptimize(message.toPublishString());
+    });
+    NullPrint out;
+    Benchmark::run("message/writeTo stream", [&message, &out]() {
+        JSONWriter json(out);
+        message.writeTo(json);
+    });
+    Messages_t messages(10, message);
+    Benchmark::run("message/batch body (10 messages)", [&messages]() {
+        String body = jsonToString([&messages](JSONWriter& json) {
+            json.beginArray();
+            for (auto const& entry: messages) {
+                entry.writeTo(json);
+            }
+            json.endArray();
+        });
+        Benchmark::doNotOptimize(body);
+    });
+}
+
+static void benchmarkForms() {
+    Properties data = JSON(configBody, strlen(configBody)).parseObject("");
+    Benchmark::run("properties/get", [&data]() {
+        Benchmark::doNotOptimize(data.get("battery/normalVoltageSleepTimeInSeconds").c_str());
+    });
+    Benchmark::run("form/parse (battery)", []() {
+        FormTemplate form(batteryForm);
+        Benchmark::doNotOptimize(form);
+    });
+    FormTemplate form(batteryForm);
+    NullPrint out;
+    Benchmark::run("form/render (battery)", [&form, &data, &out]() {
+        form.render(data, out);
+    });
+}
+
+/**
+ * Stand-in broker, answers batches with 404, if it does not support them
+ */
+static bool isBatchEndpoint = true;
+
+static int handleBrokerRequest(const String& method, const String& uri, const Loopback::headers_t& headers,
+    const String& body, String& response) 
+{
+    if (uri == "/publish/batch" && !isBatchEndpoint) {
+        return 404;
+    }
+    if (uri == "/connect") {
+        response = "{\"token\":{\"send\":\"s\",\"receive\":\"r\"}}";
+    }
+    return 200;
+}
+
+/**
+ * Runs the broker part of a wake cycle: connect, subscribe, publish and flush the messages of all 
+ * devices and disconnect. Prints the simulated time of the cycle, the network latency is 
+ * simulated by the loopback broker.
+ * @param name name printed in the result table
+ * @param messageAmount amount of messages published in the cycle
+ */
+static void benchmarkPublishCycle(const char* name, uint8_t messageAmount) {
+    Messages_t messages;
+    for (uint8_t i = 0; i < messageAmount; i++) {
+        messages.push_back(Message("area/level/room/device/sensor/value" + String(i), String(i * 1.5F)));
+    }
+    BrokerProxy proxy;
+    Loopback::resetStatistics();
+    uint32_t start = millis();
+    proxy.connect();
+    proxy.publishMessages(messages);
+    proxy.closeDown();
+    printf("%-40s %12u %12u %14u\n", name, unsigned(millis() - start), unsigned(Loopback::getRequestAmount()), 
+        unsigned(Loopback::getConnectAmount()));
+}
+
+/**
+ * Compares batched and single publishes with 30 ms per tcp connect and 20 ms per request
+ */
+static void benchmarkPublish() {
+    const uint32_t WLAN_CONNECT_TIME = 3000;
+    Loopback::setHandler(handleBrokerRequest);
+    Loopback::setLatency(30, 20);
+    WiFi.begin("bench");
+    delay(WLAN_CONNECT_TIME);
+    printf("\n%-40s %12s %12s %14s\n", "wake cycle (simulated time)", "ms/cycle", "requests", "connects");
+    isBatchEndpoint = true;
+    benchmarkPublishCycle("publish/20 messages batched", 20);
+    isBatchEndpoint = false;
+    benchmarkPublishCycle("publish/20 messages one by one", 20);
+}
+
+int main(int argc, char* argv[]) {
+    Benchmark::printHeader();
+    benchmarkJSON();
+    benchmarkLegacyJSON();
+    benchmarkMessages();
+    benchmarkForms();
+    benchmarkPublish();
+    return 0;
+}
+
+#endif
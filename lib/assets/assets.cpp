@@ -0,0 +1,160 @@
+/**
+ * Generated by scripts/build_assets.py from web/, do not edit
+ */
+
+#include "assets.h"
+
+static const uint8_t cssCssGz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x55, 0xdb, 0x8e, 0xda, 0x30,
+    0x10, 0xfd, 0x95, 0x74, 0x57, 0x95, 0x76, 0x5b, 0x82, 0x12, 0x20, 0x0b, 0x38, 0xea, 0x03, 0x5a,
+    0xed, 0xaa, 0x4f, 0xed, 0x4b, 0xdf, 0xaa, 0x3e, 0x38, 0xb6, 0x43, 0x2c, 0x8c, 0x1d, 0xd9, 0xe6,
+    0xb6, 0x11, 0xff, 0x5e, 0x5f, 0x72, 0x01, 0x92, 0x55, 0xbb, 0x41, 0x20, 0x62, 0x7b, 0x66, 0x8e,
+    0x67, 0xce, 0x99, 0xc9, 0x04, 0x3e, 0x55, 0xb9, 0xe0, 0x3a, 0xcc, 0xe1, 0x96, 0xb2, 0x13, 0x58,
+    0x49, 0x0a, 0xd9, 0xe8, 0x3b, 0x61, 0x7b, 0xa2, 0x29, 0x82, 0x23, 0x05, 0xb9, 0x0a, 0x15, 0x91,
+    0x34, 0x3f, 0x7f, 0xa9, 0x32, 0x71, 0x0c, 0x15, 0x7d, 0xa3, 0x7c, 0x0d, 0x32, 0x21, 0x31, 0x91,
+    0xa1, 0x59, 0x39, 0x53, 0x5e, 0xee, 0x34, 0xe0, 0x42, 0x3f, 0xfc, 0xd6, 0xa7, 0x92, 0x7c, 0x53,
+    0xbb, 0x6c, 0x4b, 0xf5, 0x9f, 0xc7, 0xea, 0x40, 0xb1, 0x2e, 0x40, 0x1c, 0x45, 0x9f, 0xd3, 0x12,
+    0x62, 0x6c, 0xcd, 0xe2, 0x49, 0x79, 0x4c, 0xbd, 0x2d, 0x88, 0xcb, 0x63, 0xa0, 0x04, 0xa3, 0x38,
+    0xb8, 0x47, 0x08, 0xd5, 0xab, 0xa1, 0x84, 0x98, 0xee, 0x14, 0x98, 0xb9, 0x73, 0x03, 0xe1, 0xd2,
+    0x2d, 0x94, 0x6b, 0xca, 0x43, 0x2d, 0x4a, 0xf0, 0x54, 0xb6, 0xaf, 0x99, 0xd0, 0x5a, 0x6c, 0x41,
+    0x6c, 0x97, 0x24, 0x31, 0x56, 0x04, 0xec, 0x89, 0xb4, 0x57, 0x60, 0x1e, 0xe0, 0x15, 0xb6, 0x2a,
+    0x83, 0x68, 0xb3, 0x96, 0x62, 0xc7, 0x71, 0x88, 0x04, 0x13, 0x12, 0xdc, 0xcf, 0x9e, 0x57, 0xaf,
+    0x49, 0x94, 0xfa, 0xb7, 0x43, 0x41, 0x35, 0xb9, 0x02, 0x1d, 0x4c, 0xa2, 0x0e, 0x39, 0x17, 0x9c,
+    0x0c, 0xe0, 0x45, 0x3b, 0xa9, 0x8c, 0x71, 0x29, 0x28, 0xd7, 0x44, 0xfa, 0xb0, 0x63, 0x9d, 0x55,
+    0xad, 0x1f, 0xe3, 0x22, 0x88, 0x13, 0xfb, 0x63, 0xef, 0xfe, 0x89, 0x6e, 0x4b, 0x21, 0x35, 0xe4,
+    0x3a, 0x75, 0x15, 0x70, 0xa0, 0xe3, 0xc5, 0xf5, 0x4e, 0x1f, 0xe8, 0xfc, 0x65, 0x19, 0xcd, 0xe7,
+    0x69, 0x9b, 0x5c, 0x13, 0xb8, 0x20, 0x74, 0x5d, 0x68, 0x30, 0xb3, 0x20, 0x9c, 0xab, 0x83, 0x5f,
+    0xc8, 0x04, 0xc3, 0xa9, 0x26, 0x47, 0xe3, 0xbb, 0x80, 0x58, 0x1c, 0x5c, 0xca, 0xed, 0xb7, 0x71,
+    0x52, 0xbb, 0xcc, 0xdd, 0x73, 0x73, 0x23, 0x83, 0x33, 0x0d, 0xb7, 0xe2, 0x2d, 0x1c, 0x58, 0x3e,
+    0x90, 0x6c, 0x43, 0xf5, 0xc0, 0x4e, 0xbf, 0xb4, 0x8b, 0xd5, 0x72, 0xb2, 0x98, 0xdf, 0xe4, 0xc6,
+    0x97, 0xd6, 0x63, 0x8a, 0x1c, 0xa2, 0x28, 0x90, 0xeb, 0x0c, 0x3e, 0x4c, 0x92, 0x64, 0xd4, 0x7c,
+    0xa3, 0x71, 0xf2, 0x18, 0x50, 0xae, 0x88, 0x6e, 0x70, 0x7c, 0xcc, 0xa6, 0x05, 0xf9, 0x11, 0xb3,
+    0x33, 0x83, 0x19, 0x61, 0xb6, 0x6a, 0x98, 0xaa, 0x92, 0xc1, 0x13, 0xa0, 0x9c, 0x51, 0x4e, 0xc2,
+    0x8c, 0x09, 0xb4, 0x69, 0xb2, 0x9e, 0xd8, 0xac, 0xd7, 0xc9, 0x5b, 0x2c, 0x16, 0xa9, 0x3b, 0x51,
+    0x57, 0xc1, 0xee, 0x0d, 0x50, 0x0e, 0x14, 0xc2, 0x10, 0x72, 0x88, 0x78, 0x09, 0x8c, 0x66, 0xcb,
+    0xf3, 0x18, 0x99, 0xc2, 0x41, 0xe3, 0xc7, 0x9c, 0xe9, 0xa7, 0xb5, 0x67, 0x95, 0x4f, 0xec, 0xa7,
+    0xa5, 0xa8, 0x65, 0xe7, 0x79, 0x6c, 0x34, 0xc1, 0xe1, 0xbe, 0xb2, 0x81, 0x72, 0x66, 0xee, 0x5b,
+    0x50, 0x8c, 0x09, 0x1f, 0xb0, 0x9e, 0x4e, 0xa7, 0xcd, 0xe9, 0x00, 0x56, 0xe6, 0x2c, 0xd4, 0x80,
+    0x91, 0x5c, 0xa7, 0xd7, 0xde, 0x1d, 0x75, 0x20, 0xa3, 0x6b, 0x0e, 0x10, 0x71, 0x75, 0x6b, 0xa9,
+    0x3c, 0xb3, 0x4c, 0xb2, 0x62, 0x73, 0x67, 0x30, 0x41, 0x42, 0x42, 0x4d, 0x05, 0xf7, 0xda, 0xb8,
+    0xe0, 0xf3, 0xbc, 0x03, 0x16, 0xc0, 0x77, 0x93, 0x80, 0x31, 0xae, 0x63, 0x67, 0xcc, 0x6c, 0x76,
+    0x16, 0x63, 0x88, 0x34, 0xdd, 0x93, 0xff, 0x12, 0xec, 0x79, 0xac, 0x0e, 0x55, 0x29, 0x14, 0x75,
+    0x40, 0x24, 0x61, 0xd0, 0x9a, 0xb6, 0x4a, 0x89, 0x2f, 0x98, 0xbb, 0x33, 0x2d, 0xcd, 0xb4, 0x35,
+    0x46, 0x90, 0xf6, 0x88, 0x1d, 0xc3, 0x06, 0x56, 0x55, 0x7f, 0xf1, 0xa6, 0xe3, 0x24, 0xe5, 0x55,
+    0x4f, 0x8a, 0x5d, 0x25, 0xd4, 0x21, 0x44, 0x05, 0x41, 0x1b, 0x43, 0xbe, 0x0e, 0x11, 0xcc, 0x8c,
+    0x26, 0x76, 0xa6, 0xb1, 0x88, 0x12, 0x22, 0xaa, 0x4f, 0x20, 0x4a, 0x6b, 0x3d, 0x84, 0x64, 0x6f,
+    0xf2, 0xab, 0x9c, 0x7f, 0x67, 0xec, 0x58, 0xd8, 0x52, 0xd0, 0x73, 0xef, 0xb6, 0xac, 0x3d, 0x49,
+    0x39, 0xe9, 0x4d, 0x3a, 0xe9, 0x2d, 0xdd, 0xd3, 0x97, 0xb5, 0x8b, 0x40, 0xb9, 0xa5, 0xda, 0x75,
+    0x04, 0x9f, 0xa9, 0x89, 0x6d, 0xd8, 0xf5, 0x8d, 0x2c, 0x29, 0x40, 0xe8, 0x5a, 0xb8, 0x96, 0x66,
+    0x14, 0xf8, 0x8b, 0xf8, 0xcd, 0x20, 0x1a, 0x4f, 0x55, 0x40, 0xa0, 0x22, 0xa1, 0x7d, 0x51, 0x9d,
+    0x5b, 0x90, 0x91, 0x5c, 0x48, 0x32, 0xea, 0x16, 0x60, 0xae, 0x7b, 0xd1, 0x2e, 0x68, 0xe7, 0x03,
+    0x27, 0x26, 0x4a, 0x2d, 0xa2, 0xa9, 0x15, 0x58, 0x43, 0xb6, 0xe8, 0x4a, 0x5f, 0x6e, 0xeb, 0x82,
+    0x60, 0xb3, 0x56, 0x8a, 0xbe, 0x6b, 0x5f, 0x4e, 0xb3, 0x5f, 0x92, 0x64, 0x3b, 0x53, 0x08, 0x3d,
+    0xf2, 0x73, 0xad, 0x9b, 0x66, 0xfd, 0x3e, 0x39, 0x3c, 0xdc, 0x6e, 0xef, 0x54, 0x59, 0x99, 0x9a,
+    0x5a, 0x81, 0xbb, 0x9f, 0x3f, 0xee, 0x1a, 0x84, 0x3e, 0x4d, 0x71, 0x34, 0xa8, 0xd4, 0xe9, 0x6c,
+    0x35, 0x7f, 0x8e, 0x1b, 0x65, 0xbd, 0xba, 0xe7, 0x7c, 0x9b, 0x99, 0xce, 0xeb, 0xeb, 0x6b, 0xe7,
+    0x56, 0x3a, 0x74, 0xef, 0xf8, 0x7d, 0x71, 0x4f, 0xe3, 0xb7, 0xae, 0xf5, 0x85, 0x62, 0x9d, 0xb1,
+    0x0b, 0xa4, 0x0e, 0x54, 0xa3, 0x62, 0xb0, 0xd6, 0x76, 0xdc, 0xd4, 0xb5, 0x76, 0xd3, 0xb4, 0x0b,
+    0xd3, 0x40, 0x4d, 0xfb, 0xf4, 0xb5, 0x34, 0x8f, 0xd2, 0x9a, 0xff, 0x51, 0xea, 0x51, 0x3e, 0xcd,
+    0xbb, 0xf6, 0xff, 0x2f, 0x0e, 0xba, 0x59, 0x7a, 0xc1, 0x27, 0xc8, 0xd8, 0x20, 0x99, 0x1a, 0x09,
+    0x01, 0xf7, 0x87, 0xe0, 0xe0, 0x6b, 0xd0, 0x8a, 0x23, 0xe8, 0x48, 0x7c, 0xc9, 0xd5, 0xe8, 0xff,
+    0x0c, 0xeb, 0x94, 0x78, 0xe8, 0x56, 0xb1, 0x7f, 0x01, 0x3d, 0x01, 0xf6, 0xbd, 0x09, 0x09, 0x00,
+    0x00
+};
+
+const StaticAsset staticAssets[] = {
+    { "/css.css", "text/css", "\"47ec4ee1\"", (PGM_P) cssCssGz, 865, true }
+};
+const uint8_t staticAssetCount = 1;
+
+const char headHtml[] PROGMEM =
+    "<!DOCTYPE html><html><head><meta name=\"viewport\" content=\"width=device-width, initial-scale=1\"><"
+    "link rel=\"stylesheet\" type=\"text/css\" href=\"css.css\"></head><body>";
+
+const char batteryForm[] PROGMEM =
+    "<form action=\"/battery\" method=\"POST\"><label for=\"voltage\">Current voltage</label><input type="
+    "\"text\" id=\"voltage\" name=\"battery/voltage\" [value]=\"battery/voltage\"><label for=\"sleepTime"
+    "\">Resulting sleep time in seconds</label><input type=\"text\" id=\"sleepTime\" name=\"battery/sleep"
+    "TimeInSeconds\" [value]=\"battery/sleepTimeInSeconds\"><label for=\"calibration\">Voltage calibratio"
+    "n divisor</label><input type=\"text\" id=\"calibration\" name=\"battery/voltageCalibrationDivisor\" "
+    "[value]=\"battery/voltageCalibrationDivisor\"><label for=\"highVoltage\">High voltage</label><input "
+    "type=\"text\" id=\"highVoltage\" name=\"battery/highVoltage\" [value]=\"battery/highVoltage\"><label"
+    " for=\"lowVoltage\">Low voltage</label><input type=\"text\" id=\"lowVoltage\" name=\"battery/lowVolt"
+    "age\" [value]=\"battery/lowVoltage\"><label for=\"highTime\">High voltage sleep time in seconds</lab"
+    "el><input type=\"text\" id=\"highTime\" name=\"battery/highVoltageSleepTimeInSeconds\" [value]=\"bat"
+    "tery/highVoltageSleepTimeInSeconds\"><label for=\"normalTime\">Normal voltage sleep time in seconds<"
+    "/label><input type=\"text\" id=\"normalTime\" name=\"battery/normalVoltageSleepTimeInSeconds\" [valu"
+    "e]=\"battery/normalVoltageSleepTimeInSeconds\"><label for=\"normalTime\">Low voltage sleep time in s"
+    "econds</label><input type=\"text\" id=\"lowTime\" name=\"battery/lowVoltageSleepTimeInSeconds\" [val"
+    "ue]=\"battery/lowVoltageSleepTimeInSeconds\"><label for=\"minTime\">Minimal adaptive sleep time in s"
+    "econds</label><input type=\"text\" id=\"minTime\" name=\"battery/minSleepTimeInSeconds\" [value]=\"b"
+    "attery/minSleepTimeInSeconds\"><label for=\"maxTime\">Maximal adaptive sleep time in seconds</label>"
+    "<input type=\"text\" id=\"maxTime\" name=\"battery/maxSleepTimeInSeconds\" [value]=\"battery/maxSlee"
+    "pTimeInSeconds\"><input type=\"hidden\" name=\"battery/mode\" display=\"hidden\" value=\"off\"><labe"
+    "l for=\"batteryMode\">Battery mode enabled</label><div class=\"sw\"><input type=\"checkbox\" name=\""
+    "battery/mode\" class=\"sw-checkbox\" id=\"batteryMode\" tabindex=\"0\" [checked]=\"battery/mode\"><l"
+    "abel class=\"sw-label\" for=\"batteryMode\"><span class=\"sw-inner\"></span><span class=\"sw-switch"
+    "\"></span></label></div><input type=\"submit\" value=\"Submit\"></form>";
+
+const char brokerForm[] PROGMEM =
+    "<form action=\"/broker\" method=\"POST\"><label for=\"brokerhost\">Broker host</label><input type=\""
+    "text\" id=\"brokerhost\" name=\"broker/host\" placeholder=\"Broker host...\" [value]=\"broker/host\""
+    "><label for=\"brokerport\">Broker port</label><input type=\"number\" id=\"brokerport\" name=\"broker"
+    "/port\" [value]=\"broker/port\"><label for=\"clientname\">Client name</label><input type=\"text\" id"
+    "=\"clientname\" name=\"broker/clientName\" [value]=\"broker/clientName\"><label for=\"basetopic\">Ba"
+    "se topic</label><input type=\"text\" id=\"basetopic\" name=\"broker/baseTopic\" [value]=\"broker/bas"
+    "eTopic\"><label for=\"subscribeto\">Subscribe topic</label><input type=\"text\" id=\"subscribeto\" n"
+    "ame=\"broker/subscribeTo\" [value]=\"broker/subscribeTo\"><input type=\"submit\" value=\"Submit\"></"
+    "form>";
+
+const char digitalsensorForm[] PROGMEM =
+    "<form><label for=\"rain\">Rain</label><input type=\"text\" id=\"rain\" readonly [value]=\"sensor/rai"
+    "n\"></form>";
+
+const char irrigationForm[] PROGMEM =
+    "<form action=\"/irrigation\" method=\"POST\"><label for=\"Humidity\">Current humidity</label><input "
+    "type=\"text\" id=\"Humidity\" [value]=\"sensor/humidity\"><label for=\"lowDuration\">Low humidity ir"
+    "rigation duration in seconds (30% rH)</label><input type=\"text\" id=\"lowDuration\" name=\"irrigati"
+    "on/lowDurationInSeconds\" [value]=\"irrigation/lowDurationInSeconds\"><label for=\"lowWakeup\">Low h"
+    "umidity amount of wakeups until irrigation (30% rH)</label><input type=\"text\" id=\"lowWakeup\" nam"
+    "e=\"irrigation/lowWakeup\" [value]=\"irrigation/lowWakeup\"><label for=\"highDuration\">High humidit"
+    "y irrigation duration in seconds (60% rH)</label><input type=\"text\" id=\"highDuration\" name=\"irr"
+    "igation/highDurationInSeconds\" [value]=\"irrigation/highDurationInSeconds\"><label for=\"highWakeup"
+    "\">High humidity amount of wakeups until irrigation (60% rH)</label><input type=\"text\" id=\"highWa"
+    "keup\" name=\"irrigation/highWakeup\" [value]=\"irrigation/highWakeup\"><label for=\"pump2Factor\">D"
+    "uration factor for pump 2</label><input type=\"text\" id=\"pump2Factor\" name=\"irrigation/pump2Fact"
+    "or\" [value]=\"irrigation/pump2Factor\"><input type=\"submit\" value=\"Submit\"></form>";
+
+const char softapForm[] PROGMEM =
+    "<form action=\"/\" method=\"POST\"><label for=\"ssid\">Access Point name (ssid)</label><input type="
+    "\"text\" id=\"ssid\" name=\"ap/ssid\" placeholder=\"ssid...\" [value]=\"ap/ssid\"><label for=\"passw"
+    "d\">Access Point Password</label><input type=\"password\" id=\"passwd\" name=\"ap/password\" placeho"
+    "lder=\"password...\"><label for=\"ip\">Access Point IP</label><input type=\"text\" id=\"ip\" name=\""
+    "ap/ip\" placeholder=\"ip...\" [value]=\"ap/ip\"><label for=\"gateway\">Gateway</label><input type=\""
+    "text\" id=\"gateway\" name=\"ap/gateway\" placeholder=\"gateway\" [value]=\"ap/gateway\"><label for="
+    "\"subnet\">Subnet mask</label><input type=\"text\" id=\"subnet\" name=\"ap/subnet\" placeholder=\"ga"
+    "teway\" [value]=\"ap/subnet\"><input type=\"submit\" value=\"Submit\"></form>";
+
+const char switchForm[] PROGMEM =
+    "<form action=\"/switch\" method=\"POST\"><label class=\"tb\">D4, GPIO12</label><input type=\"hidden"
+    "\" name=\"switch/D4\" id=\"D4\" value=\"toggle\"><input type=\"submit\" class=\"tb\" [value]=\"switc"
+    "h/D4\"></form><form action=\"/switch\" method=\"POST\"><label class=\"tb\">D5, GPIO12</label><input "
+    "type=\"hidden\" name=\"switch/D5\" id=\"D5\" value=\"toggle\"><input type=\"submit\" class=\"tb\" [v"
+    "alue]=\"switch/D5\"></form><form action=\"/switch\" method=\"POST\"><label class=\"tb\">D6, GPIO12</"
+    "label><input type=\"hidden\" name=\"switch/D6\" id=\"D6\" value=\"toggle\"><input type=\"submit\" cl"
+    "ass=\"tb\" [value]=\"switch/D6\"></form><form action=\"/switch\" method=\"POST\"><label class=\"tb\""
+    ">D7, GPIO13</label><input type=\"hidden\" name=\"switch/D7\" id=\"D7\" value=\"toggle\"><input type="
+    "\"submit\" class=\"tb\" [value]=\"switch/D7\"></form>";
+
+const char weatherForm[] PROGMEM =
+    "<form><label for=\"temperature\">Temperature</label><input type=\"text\" id=\"temperature\" readonly"
+    " [value]=\"sensor/temperature\"><label for=\"humidity\">Humidity</label><input type=\"text\" id=\"hu"
+    "midity\" readonly [value]=\"sensor/humidity\"><label for=\"pressure\">Barometric pressure</label><in"
+    "put type=\"text\" id=\"pressure\" readonly [value]=\"sensor/pressure\"><label for=\"battery\">Batter"
+    "y voltage</label><input type=\"text\" id=\"voltage\" readonly [value]=\"battery/voltage\"></form>";
+
+const char wlanForm[] PROGMEM =
+    "<form action=\"/\" method=\"POST\"><label for=\"ssid\">Wlan name</label><input type=\"text\" id=\"ss"
+    "id\" name=\"wlan/ssid\" placeholder=\"ssid...\" [value]=\"wlan/ssid\"><label for=\"passwd\">Wlan Pas"
+    "sword</label><input type=\"password\" id=\"passwd\" name=\"wlan/password\" placeholder=\"password..."
+    "\"><input type=\"submit\" value=\"Submit\"></form>";
@@ -0,0 +1,33 @@
+/**
+ * Generated by scripts/build_assets.py from web/, do not edit
+ * @brief
+ * Static files and html templates of the web configuration ui stored in flash
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Static file served under a fixed path
+ */
+struct StaticAsset {
+    const char* path;
+    const char* contentType;
+    const char* etag;
+    PGM_P data;
+    uint16_t length;
+    bool isGzip;
+};
+
+extern const StaticAsset staticAssets[];
+extern const uint8_t staticAssetCount;
+
+extern const char headHtml[];
+extern const char batteryForm[];
+extern const char brokerForm[];
+extern const char digitalsensorForm[];
+extern const char irrigationForm[];
+extern const char softapForm[];
+extern const char switchForm[];
+extern const char weatherForm[];
+extern const char wlanForm[];
@@ -20,66 +20,47 @@ Battery::Configuration::Configuration() {
     highVoltage = 3.5;
     lowVoltage = 3.1;
     batteryMode = 0;
+    minSleepTimeInSeconds = 120;
+    maxSleepTimeInSeconds = 3600;
+    layoutVersion = LAYOUT_VERSION;
 }
 
-std::map<String, String> Battery::Configuration::get()
+Properties Battery::Configuration::get()
 {
-    std::map<String, String> result;
-    result["battery/voltageCalibrationDivisor"] = voltageCalibrationDivisor;
-    result["battery/highVoltageSleepTimeInSeconds"] = highVoltageSleepTimeInSeconds;
-    result["battery/lowVoltageSleepTimeInSeconds"] = lowVoltageSleepTimeInSeconds;
-    result["battery/normalVoltageSleepTimeInSeconds"] = normalVoltageSleepTimeInSeconds;
-    result["battery/highVoltage"] = highVoltage;
-    result["battery/lowVoltage"] = lowVoltage;
-    result["battery/mode"] = batteryMode ? "on" : "off";
+    Properties result;
+    result.set(StaticKey("battery/voltageCalibrationDivisor"), String(voltageCalibrationDivisor));
+    result.set(StaticKey("battery/highVoltageSleepTimeInSeconds"), String(highVoltageSleepTimeInSeconds));
+    result.set(StaticKey("battery/lowVoltageSleepTimeInSeconds"), String(lowVoltageSleepTimeInSeconds));
+    result.set(StaticKey("battery/normalVoltageSleepTimeInSeconds"), String(normalVoltageSleepTimeInSeconds));
+    result.set(StaticKey("battery/highVoltage"), String(highVoltage));
+    result.set(StaticKey("battery/lowVoltage"), String(lowVoltage));
+    result.set(StaticKey("battery/mode"), batteryMode ? "on" : "off");
+    result.set(StaticKey("battery/minSleepTimeInSeconds"), String(minSleepTimeInSeconds));
+    result.set(StaticKey("battery/maxSleepTimeInSeconds"), String(maxSleepTimeInSeconds));
     return result;
 }
 
-void Battery::Configuration::set(std::map<String, String> config)
+void Battery::Configuration::set(const Properties& config)
 {
-    voltageCalibrationDivisor = config["battery/voltageCalibrationDivisor"].toFloat();
-    highVoltageSleepTimeInSeconds = config["battery/highVoltageSleepTimeInSeconds"].toFloat();
-    lowVoltageSleepTimeInSeconds = config["battery/lowVoltageSleepTimeInSeconds"].toFloat();
-    normalVoltageSleepTimeInSeconds = config["battery/normalVoltageSleepTimeInSeconds"].toFloat();
-    highVoltage = config["battery/highVoltage"].toFloat();
-    lowVoltage = config["battery/lowVoltage"].toFloat();
-    PRINTLN_VARIABLE_IF_DEBUG(config["battery/mode"])
-    batteryMode = config["battery/mode"] == "on" ? 1 : 0;
+    voltageCalibrationDivisor = config.get("battery/voltageCalibrationDivisor").toFloat();
+    highVoltageSleepTimeInSeconds = config.get("battery/highVoltageSleepTimeInSeconds").toFloat();
+    lowVoltageSleepTimeInSeconds = config.get("battery/lowVoltageSleepTimeInSeconds").toFloat();
+    normalVoltageSleepTimeInSeconds = config.get("battery/normalVoltageSleepTimeInSeconds").toFloat();
+    highVoltage = config.get("battery/highVoltage").toFloat();
+    lowVoltage = config.get("battery/lowVoltage").toFloat();
+    PRINTLN_VARIABLE_IF_DEBUG(config.get("battery/mode"))
+    batteryMode = config.get("battery/mode") == "on" ? 1 : 0;
+    minSleepTimeInSeconds = config.get("battery/minSleepTimeInSeconds").toInt();
+    maxSleepTimeInSeconds = config.get("battery/maxSleepTimeInSeconds").toInt();
+    limitSleepTimeBounds();
 }
 
-const char* Battery::htmlForm = 
-    R"htmlform(
-    <form action="/battery" method="POST">
-    <label for="voltage">Current voltage</label>
-    <input type="text" id="voltage" name="battery/voltage" [value]="battery/voltage">
-    <label for="sleepTime">Resulting sleep time in seconds</label>
-    <input type="text" id="sleepTime" name="battery/sleepTimeInSeconds" [value]="battery/sleepTimeInSeconds">
-    <label for="calibration">Voltage calibration divisor</label>
-    <input type="text" id="calibration" name="battery/voltageCalibrationDivisor" [value]="battery/voltageCalibrationDivisor">
-    <label for="highVoltage">High voltage</label>
-    <input type="text" id="highVoltage" name="battery/highVoltage" [value]="battery/highVoltage">
-    <label for="lowVoltage">Low voltage</label>
-    <input type="text" id="lowVoltage" name="battery/lowVoltage" [value]="battery/lowVoltage">
-    <label for="highTime">High voltage sleep time in seconds</label>
-    <input type="text" id="highTime" name="battery/highVoltageSleepTimeInSeconds" [value]="battery/highVoltageSleepTimeInSeconds">
-    <label for="normalTime">Normal voltage sleep time in seconds</label>
-    <input type="text" id="normalTime" name="battery/normalVoltageSleepTimeInSeconds" [value]="battery/normalVoltageSleepTimeInSeconds">
-    <label for="normalTime">Low voltage sleep time in seconds</label>
-    <input type="text" id="lowTime" name="battery/lowVoltageSleepTimeInSeconds" [value]="battery/lowVoltageSleepTimeInSeconds">
-    <input type="hidden" name="battery/mode" display="hidden" value="off">
-
-    <label for="batteryMode">Battery mode enabled</label>
-    <div class="sw">
-    <input type="checkbox" name="battery/mode" class="sw-checkbox" id="batteryMode" tabindex="0" [checked]="battery/mode">
-    <label class="sw-label" for="batteryMode">
-        <span class="sw-inner"></span>
-        <span class="sw-switch"></span>
-    </label>
-    </div>
-
-    <input type="submit" value="Submit">
-    </form>
-    )htmlform";
+void Battery::Configuration::limitSleepTimeBounds() {
+    if (maxSleepTimeInSeconds > 0 && minSleepTimeInSeconds > maxSleepTimeInSeconds) {
+        PRINTLN_IF_DEBUG("Minimal sleep time exceeds the maximal sleep time, limited to the maximum")
+        minSleepTimeInSeconds = maxSleepTimeInSeconds;
+    }
+}
 
 uint16_t Battery::writeConfigToEEPROM(uint16_t EEPROMAddress) {
     EEPROMAccess::write(EEPROMAddress, (uint8_t*) &_config, sizeof(_config));
@@ -87,8 +68,18 @@ uint16_t Battery::writeConfigToEEPROM(uint16_t EEPROMAddress) {
 }
 
 uint16_t Battery::readConfigFromEEPROM(uint16_t EEPROMAddress) { 
+    // Layout 1 ended before the sleep time bounds
+    const uint16_t LAYOUT_1_SIZE = offsetof(Configuration, minSleepTimeInSeconds);
     EEPROMAccess::read(EEPROMAddress, (uint8_t*) &_config, sizeof(_config));
-    return EEPROMAddress + sizeof(_config);
+    if (_config.layoutVersion == LAYOUT_VERSION) {
+        _config.limitSleepTimeBounds();
+        return EEPROMAddress + sizeof(_config);
+    }
+    // Keeps the offsets of the following devices until the configuration is written again
+    PRINTLN_IF_DEBUG("Migrating battery configuration from layout 1")
+    _config = Configuration();
+    EEPROMAccess::read(EEPROMAddress, (uint8_t*) &_config, LAYOUT_1_SIZE);
+    return EEPROMAddress + LAYOUT_1_SIZE;
 }
 
 Messages_t Battery::getMessages(const String& baseTopic) {
@@ -105,6 +96,24 @@ Messages_t Battery::getMessages(const String& baseTopic) {
 }
 
 uint16_t Battery::getSleepTimeInSeconds() {
+    const uint64_t MICROSECONDS_IN_A_SECOND = 1000000;
+    // Longer deep sleeps overflow the RTC timer and never wake up
+    uint16_t maxSleepTimeInSeconds = std::min(ESP.deepSleepMax() / MICROSECONDS_IN_A_SECOND, uint64_t(UINT16_MAX));
+    if (_config.maxSleepTimeInSeconds > 0 && _config.maxSleepTimeInSeconds < maxSleepTimeInSeconds) {
+        maxSleepTimeInSeconds = _config.maxSleepTimeInSeconds;
+    }
+    _reading.voltage = measureVoltage();
+    return _planner.getSleepTimeInSeconds(getVoltageSleepTimeInSeconds(), 
+        std::min(_config.minSleepTimeInSeconds, maxSleepTimeInSeconds), maxSleepTimeInSeconds, _reading);
+}
+
+void Battery::closeDown() {
+    uint16_t sleepTimeInSeconds = getSleepTimeInSeconds();
+    _planner.store(_reading, sleepTimeInSeconds);
+    sendMessageToDevices("battery/sleepTimeInSeconds", String(sleepTimeInSeconds));
+}
+
+uint16_t Battery::getVoltageSleepTimeInSeconds() {
     if (isLowVoltage()) {
         return _config.lowVoltageSleepTimeInSeconds;
     } else if (isHighVoltage()) {
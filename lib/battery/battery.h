@@ -12,8 +12,10 @@
 
 #include <Arduino.h>
 #include <message.h>
-#include <map>
+#include <properties.h>
 #include <idevice.h>
+#include <assets.h>
+#include "sleepplanner.h"
 
 class Battery : public IDevice
 {
@@ -28,24 +30,33 @@ public:
         float voltageCalibrationDivisor;
         float highVoltage;
         float lowVoltage;
+        uint16_t minSleepTimeInSeconds;
+        uint16_t maxSleepTimeInSeconds;
+        // LAYOUT_VERSION, missing in EEPROM records of layout 1 ending before the sleep time bounds
+        uint16_t layoutVersion;
 
         /**
          * Gets the configuration as key/value map
          */
-        std::map<String, String> get();
+        Properties get();
 
         /**
          * Sets the configuration from a key/value map
          * @param config configuration settings in a map
          */
-        void set(std::map<String, String> config);
+        void set(const Properties& config);
+
+        /**
+         * Limits the minimal sleep time to the maximal sleep time, 0 as maximum is unbounded
+         */
+        void limitSleepTimeBounds();
     };
     Battery(){};
 
     /**
      * Sets the battery configuration
      */
-    virtual void setConfig(jsonObject_t& config) { 
+    virtual void setConfig(const Properties& config) { 
         _config.set(config); 
         setBatteryMode(_config.batteryMode);
     }
@@ -58,12 +69,19 @@ public:
         if (key == "rtc/startType" && value == "fastReset") { 
             setBatteryMode(false);
         }
+        if (key == "sensor/temperature") {
+            _reading.temperature = value.toFloat();
+            _reading.hasClimate = true;
+        }
+        if (key == "sensor/humidity") {
+            _reading.humidity = value.toFloat();
+        }
     }
 
     /**
      * Gets the battery configuraiton
      */
-    virtual jsonObject_t getConfig() { 
+    virtual Properties getConfig() { 
         return _config.get();
     }
 
@@ -97,10 +115,22 @@ public:
     }
 
     /**
-     * @returns the sleep time in seconds depending on the battery voltage
+     * Stores the readings of this wake cycle for the adaption of the next sleep times
+     */
+    virtual void closeDown();
+
+    /**
+     * @returns the sleep time in seconds depending on the battery voltage, adapted to the 
+     * change rate of temperature and humidity and to the battery trend, limited to the maximal 
+     * deep sleep time of the chip
      */
     uint16_t getSleepTimeInSeconds();
 
+    /**
+     * @returns the sleep time in seconds configured for the battery voltage
+     */
+    uint16_t getVoltageSleepTimeInSeconds();
+
     /**
      * Gets a yaha messages to send the battery voltage
      */
@@ -109,12 +139,10 @@ public:
     /**
      * Gets an info about the matching html page
      */
-    virtual HtmlPageInfo getHtmlPage() { return HtmlPageInfo(htmlForm, "/battery", "Battery"); }
+    virtual HtmlPageInfo getHtmlPage() { return HtmlPageInfo(batteryForm, "/battery", "Battery"); }
 
 private:
 
-    static const char* htmlForm;
-
     /**
      * @param mode true, to set battery mode on
      */
@@ -145,6 +173,10 @@ private:
     }
 
     static const uint8_t BATTERY_PIN = A0;
+    // EEPROM layout of the configuration, "BA" and the layout number
+    static const uint16_t LAYOUT_VERSION = 0xBA02;
 
     Configuration _config;
+    SleepPlanner _planner;
+    SleepPlanner::Reading _reading;
 };
\ No newline at end of file
@@ -0,0 +1,120 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Adapts the deep sleep time to the change rate of the sensor values and the battery trend
+ */
+
+#define __DEBUG
+#include <debug.h>
+#include <rtcmem.h>
+#include "sleepplanner.h"
+
+// Change rates per hour, above the fast rate the sleep time is halved, below the stable rate raised
+static const float FAST_TEMPERATURE_RATE = 2.0;
+static const float STABLE_TEMPERATURE_RATE = 0.5;
+static const float FAST_HUMIDITY_RATE = 10.0;
+static const float STABLE_HUMIDITY_RATE = 2.0;
+// Voltage drop in mV over the history, counted as trend and not as noise of the ADC
+static const int32_t VOLTAGE_TREND_DROP = 20;
+
+void SleepPlanner::load() {
+    if (_isLoaded) {
+        return;
+    }
+    static_assert(RTCMem<RTCHistory>::getBlockAmount() <= RTC_SAMPLE_BLOCK - RTC_SLEEP_BLOCK,
+        "RTCHistory does not fit into its RTC memory blocks");
+    _history = RTCMem<RTCHistory>::read(RTC_SLEEP_BLOCK);
+    if (_history.magic != MAGIC_NUMBER || _history.next >= HISTORY_SIZE || 
+        _history.factor < MIN_FACTOR || _history.factor > MAX_FACTOR) 
+    {
+        memset(&_history, 0, sizeof(_history));
+        _history.magic = MAGIC_NUMBER;
+        _history.factor = FACTOR_ONE;
+    }
+    _isLoaded = true;
+}
+
+const SleepPlanner::Sample& SleepPlanner::getSample(uint8_t age) {
+    return _history.samples[(_history.next + HISTORY_SIZE - 1 - age) % HISTORY_SIZE];
+}
+
+SleepPlanner::Sample SleepPlanner::toSample(const Reading& reading, uint16_t sleepTimeInSeconds) {
+    Sample result;
+    result.voltage = uint16_t(reading.voltage * 1000);
+    result.temperature = reading.hasClimate ? int16_t(reading.temperature * 100) : 0;
+    result.humidity = reading.hasClimate ? uint16_t(reading.humidity * 100) : 0;
+    result.sleepTimeInSeconds = sleepTimeInSeconds;
+    return result;
+}
+
+bool SleepPlanner::isVoltageTrendingDown(const Reading& reading) {
+    if (_history.amount < HISTORY_SIZE / 2) {
+        return false;
+    }
+    const Sample& oldest = getSample(_history.amount - 1);
+    return int32_t(oldest.voltage) - int32_t(reading.voltage * 1000) > VOLTAGE_TREND_DROP;
+}
+
+uint16_t SleepPlanner::getNextFactor(const Reading& reading) {
+    load();
+    if (_history.amount == 0) {
+        return _history.factor;
+    }
+    if (!reading.hasClimate) {
+        // Without climate values the change rate is unknown, only a falling voltage extends the sleep
+        return isVoltageTrendingDown(reading) ? FACTOR_ONE * 2 : FACTOR_ONE;
+    }
+    const Sample& last = getSample(0);
+    bool isStable = false;
+    bool isFast = false;
+    if (last.sleepTimeInSeconds > 0) {
+        const float SECONDS_IN_AN_HOUR = 3600;
+        float hours = last.sleepTimeInSeconds / SECONDS_IN_AN_HOUR;
+        float temperatureRate = fabs(reading.temperature - last.temperature / 100.0) / hours;
+        float humidityRate = fabs(reading.humidity - last.humidity / 100.0) / hours;
+        PRINTLN_VARIABLE_IF_DEBUG(temperatureRate)
+        PRINTLN_VARIABLE_IF_DEBUG(humidityRate)
+        isFast = temperatureRate >= FAST_TEMPERATURE_RATE || humidityRate >= FAST_HUMIDITY_RATE;
+        isStable = temperatureRate < STABLE_TEMPERATURE_RATE && humidityRate < STABLE_HUMIDITY_RATE;
+    }
+    uint32_t factor = _history.factor;
+    if (isFast) {
+        factor /= 2;
+    } else if (isStable) {
+        factor = isVoltageTrendingDown(reading) ? factor * 2 : factor * 5 / 4;
+    }
+    return std::max(uint32_t(MIN_FACTOR), std::min(factor, uint32_t(MAX_FACTOR)));
+}
+
+uint16_t SleepPlanner::getSleepTimeInSeconds(uint16_t baseTimeInSeconds, uint16_t minTimeInSeconds, 
+    uint16_t maxTimeInSeconds, const Reading& reading) 
+{
+    uint32_t factor = getNextFactor(reading);
+    uint32_t result = uint32_t(baseTimeInSeconds) * factor / FACTOR_ONE;
+    if (maxTimeInSeconds > 0) {
+        result = std::min(result, uint32_t(maxTimeInSeconds));
+    }
+    result = std::max(result, uint32_t(minTimeInSeconds));
+    // A factor beyond the bounds would delay the reaction to the next change
+    if (baseTimeInSeconds > 0) {
+        factor = result * FACTOR_ONE / baseTimeInSeconds;
+    }
+    _plannedFactor = std::max(uint32_t(MIN_FACTOR), std::min(factor, uint32_t(MAX_FACTOR)));
+    return result;
+}
+
+void SleepPlanner::store(const Reading& reading, uint16_t sleepTimeInSeconds) {
+    load();
+    _history.factor = _plannedFactor;
+    _history.samples[_history.next] = toSample(reading, sleepTimeInSeconds);
+    _history.next = (_history.next + 1) % HISTORY_SIZE;
+    if (_history.amount < HISTORY_SIZE) {
+        _history.amount++;
+    }
+    RTCMem<RTCHistory>::write(RTC_SLEEP_BLOCK, _history);
+}
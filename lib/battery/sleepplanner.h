@@ -0,0 +1,106 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Adapts the deep sleep time to the change rate of the sensor values and the battery trend. A 
+ * short history of readings is kept in RTC memory across deep sleep.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+class SleepPlanner {
+public:
+    /**
+     * Values measured in the current wake cycle
+     */
+    struct Reading {
+        Reading() : voltage(0), temperature(0), humidity(0), hasClimate(false) {}
+        float voltage;
+        float temperature;
+        float humidity;
+        bool hasClimate;
+    };
+
+    SleepPlanner() : _isLoaded(false), _plannedFactor(FACTOR_ONE) {}
+
+    /**
+     * Calculates the sleep time. The base time is multiplied with a factor, which is halved, if 
+     * temperature or humidity change fast, and raised, if they are stable. It is raised further, 
+     * if the battery voltage is trending down.
+     * @param baseTimeInSeconds sleep time without adaption
+     * @param minTimeInSeconds lower bound of the sleep time
+     * @param maxTimeInSeconds upper bound of the sleep time
+     * @param reading values of the current wake cycle
+     * @returns sleep time in seconds
+     */
+    uint16_t getSleepTimeInSeconds(uint16_t baseTimeInSeconds, uint16_t minTimeInSeconds, 
+        uint16_t maxTimeInSeconds, const Reading& reading);
+
+    /**
+     * Adds the reading, the resulting sleep time and the factor of the last call of 
+     * getSleepTimeInSeconds to the history in RTC memory. Call it once per wake cycle, right 
+     * before deep sleep.
+     * @param reading values of the current wake cycle
+     * @param sleepTimeInSeconds sleep time following the reading
+     */
+    void store(const Reading& reading, uint16_t sleepTimeInSeconds);
+
+private:
+    static const uint8_t HISTORY_SIZE = 6;
+    // Factors are stored in 1/FACTOR_ONE units
+    static const uint16_t FACTOR_ONE = 64;
+    static const uint16_t MIN_FACTOR = FACTOR_ONE / 8;
+    static const uint16_t MAX_FACTOR = FACTOR_ONE * 8;
+
+    /**
+     * Reading in RTC memory, voltage in mV, temperature in 1/100 °C, humidity in 1/100 %
+     */
+    struct Sample {
+        uint16_t voltage;
+        int16_t temperature;
+        uint16_t humidity;
+        uint16_t sleepTimeInSeconds;
+    };
+
+    struct RTCHistory {
+        uint32_t magic;
+        uint8_t amount;
+        uint8_t next;
+        uint16_t factor;
+        Sample samples[HISTORY_SIZE];
+    };
+
+    /**
+     * Reads the history from RTC memory on first use, initializes it if it is not valid
+     */
+    void load();
+
+    /**
+     * @param age 0 for the newest sample, 1 for the one before, ...
+     * @returns sample of the history
+     */
+    const Sample& getSample(uint8_t age);
+
+    /**
+     * @returns factor for the sleep time of this cycle in 1/FACTOR_ONE units
+     */
+    uint16_t getNextFactor(const Reading& reading);
+
+    /**
+     * @returns true, if the voltage dropped over the history
+     */
+    bool isVoltageTrendingDown(const Reading& reading);
+
+    static Sample toSample(const Reading& reading, uint16_t sleepTimeInSeconds);
+
+    static const uint32_t MAGIC_NUMBER = 0x534C5000 | HISTORY_SIZE;
+    bool _isLoaded;
+    uint16_t _plannedFactor;
+    RTCHistory _history;
+};
@@ -0,0 +1,247 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ */
+
+#define __DEBUG
+#include <Arduino.h>
+#include <debug.h>
+#include "brokerconnection.h"
+
+void BrokerConnection::setServer(const char* host, uint16_t port) {
+    if (_host != host || _port != port) {
+        close();
+        _host = host;
+        _port = port;
+    }
+}
+
+void BrokerConnection::close() {
+    _client.stop();
+}
+
+bool BrokerConnection::startRequest(const String& urlWithoutHost, const String& jsonBody, const headers_t& headers) {
+    if (_state != IDLE) {
+        return false;
+    }
+    _head = "PUT ";
+    _head += urlWithoutHost;
+    _head += " HTTP/1.1\r\nHost: ";
+    _head += _host;
+    _head += ':';
+    _head += _port;
+    _head += "\r\nContent-Type: application/json\r\ncache-control: no-cache\r\nversion: 1.0\r\n";
+    for (auto const& header: headers) {
+        _head += header.first;
+        _head += ": ";
+        _head += header.second;
+        _head += "\r\n";
+    }
+    _head += "Content-Length: ";
+    _head += jsonBody.length();
+    _head += "\r\nConnection: keep-alive\r\n\r\n";
+    _body = jsonBody;
+    _isRepeated = false;
+    _state = SENDING;
+    _written = 0;
+    _startTime = millis();
+    _isReused = _client.connected();
+    return true;
+}
+
+bool BrokerConnection::open() {
+    if (_client.connected()) {
+        return true;
+    }
+    _client.stop();
+    _client.setTimeout(CONNECT_TIMEOUT);
+    if (!_client.connect(_host.c_str(), _port)) {
+        PRINTLN_IF_DEBUG("Connection to broker failed")
+        return false;
+    }
+    _client.setNoDelay(true);
+    return true;
+}
+
+void BrokerConnection::send() {
+    if (_written == 0 && !open()) {
+        fail();
+        return;
+    }
+    if (!_client.connected()) {
+        fail();
+        return;
+    }
+    uint16_t total = _head.length() + _body.length();
+    size_t free = _client.availableForWrite();
+    while (free > 0 && _written < total) {
+        const String& part = _written < _head.length() ? _head : _body;
+        uint16_t offset = _written < _head.length() ? _written : _written - _head.length();
+        size_t amount = part.length() - offset;
+        if (amount > free) {
+            amount = free;
+        }
+        size_t sent = _client.write((const uint8_t*)part.c_str() + offset, amount);
+        if (sent == 0) {
+            break;
+        }
+        _written += sent;
+        free -= sent;
+    }
+    if (_written == total) {
+        _state = RECEIVING;
+        _part = STATUS_LINE;
+        _line = "";
+        _response = "";
+        _statusCode = HTTP_ERROR;
+        _remaining = 0;
+        _hasLength = false;
+        _isChunked = false;
+        _closeAfterResponse = false;
+    }
+}
+
+void BrokerConnection::handleLine() {
+    if (_part == STATUS_LINE) {
+        // HTTP/1.1 204 No Content, empty lines left from a previous response are skipped
+        if (_line.length() == 0) {
+            return;
+        }
+        int space = _line.indexOf(' ');
+        _statusCode = space < 0 ? HTTP_ERROR : _line.substring(space + 1).toInt();
+        _part = HEADER_LINE;
+        return;
+    }
+    if (_line.length() == 0) {
+        // End of header
+        bool hasNoBody = _statusCode == 204 || _statusCode == 304 || (_hasLength && _remaining == 0);
+        _part = _isChunked ? CHUNK_SIZE : BODY;
+        if (hasNoBody) {
+            complete();
+        }
+        return;
+    }
+    int colon = _line.indexOf(':');
+    if (colon < 0) {
+        return;
+    }
+    String name = _line.substring(0, colon);
+    String value = _line.substring(colon + 1);
+    name.toLowerCase();
+    value.trim();
+    value.toLowerCase();
+    if (name == "content-length") {
+        _remaining = value.toInt();
+        _hasLength = true;
+        _response.reserve(_remaining);
+    } else if (name == "transfer-encoding" && value == "chunked") {
+        _isChunked = true;
+    } else if (name == "connection" && value == "close") {
+        _closeAfterResponse = true;
+    }
+}
+
+void BrokerConnection::receive() {
+    while (_state == RECEIVING && _client.available() > 0) {
+        char ch = _client.read();
+        switch (_part) {
+            case BODY:
+                _response += ch;
+                if (_hasLength && --_remaining == 0) {
+                    complete();
+                }
+                break;
+            case CHUNK_DATA:
+                _response += ch;
+                if (--_remaining == 0) {
+                    _part = CHUNK_END;
+                }
+                break;
+            case CHUNK_END:
+                if (ch == '\n') {
+                    _part = CHUNK_SIZE;
+                }
+                break;
+            default:
+                // Status, header and chunk size lines
+                if (ch == '\r') {
+                    break;
+                }
+                if (ch != '\n') {
+                    _line += ch;
+                    break;
+                }
+                if (_part == CHUNK_SIZE && _line.length() > 0) {
+                    _remaining = strtol(_line.c_str(), 0, 16);
+                    _part = _remaining > 0 ? CHUNK_DATA : CHUNK_END;
+                    if (_remaining == 0) {
+                        complete();
+                    }
+                } else {
+                    handleLine();
+                }
+                _line = "";
+        }
+    }
+    if (_state == RECEIVING && !_client.connected()) {
+        // Without content length, the body ends with the connection
+        if (_part == BODY && !_hasLength) {
+            _closeAfterResponse = true;
+            complete();
+        } else {
+            fail();
+        }
+    }
+}
+
+void BrokerConnection::complete() {
+    _state = DONE;
+    _head = "";
+    _body = "";
+    if (_closeAfterResponse) {
+        _client.stop();
+    }
+}
+
+void BrokerConnection::fail() {
+    _client.stop();
+    bool noAnswer = _state == SENDING || (_part == STATUS_LINE && _line.length() == 0);
+    if (_isReused && !_isRepeated && noAnswer) {
+        PRINTLN_IF_DEBUG("Broker closed the connection, repeating request")
+        _isRepeated = true;
+        _isReused = false;
+        _written = 0;
+        _state = SENDING;
+        return;
+    }
+    _state = FAILED;
+    _statusCode = HTTP_ERROR;
+    _head = "";
+    _body = "";
+}
+
+BrokerConnection::State BrokerConnection::process() {
+    if ((_state == SENDING || _state == RECEIVING) && millis() - _startTime > RESPONSE_TIMEOUT) {
+        PRINTLN_IF_DEBUG("Broker response timeout")
+        _isRepeated = true;
+        fail();
+    }
+    if (_state == SENDING) {
+        send();
+    }
+    if (_state == RECEIVING) {
+        receive();
+    }
+    return _state;
+}
+
+BrokerConnection::State BrokerConnection::waitForResponse() {
+    while (process() == SENDING || _state == RECEIVING) {
+        yield();
+    }
+    return _state;
+}
@@ -0,0 +1,133 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Provides a keep-alive http connection to the broker that is processed step by step
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <map>
+#include <WiFiClient.h>
+
+typedef std::map<String, String> headers_t;
+
+/**
+ * Sends http PUT requests to the broker on one keep-alive connection. A request is started by
+ * startRequest and advanced by calling process repeatedly. process only writes as much as the
+ * tcp send buffer takes and only reads what is available, thus it never waits for the broker. 
+ * Only opening a new tcp connection blocks, at most CONNECT_TIMEOUT milliseconds.
+ */
+class BrokerConnection {
+public:
+    enum State { IDLE, SENDING, RECEIVING, DONE, FAILED };
+
+    static const int HTTP_ERROR = -1;
+    static const uint16_t CONNECT_TIMEOUT = 2000;
+    static const uint16_t RESPONSE_TIMEOUT = 5000;
+
+    BrokerConnection() : _port(0), _state(IDLE) {}
+
+    /**
+     * Sets the broker address, closes the connection, if the address changed
+     * @param host broker host name or ip address
+     * @param port broker port
+     */
+    void setServer(const char* host, uint16_t port);
+
+    /**
+     * Starts a PUT request
+     * @param urlWithoutHost url 
+     * @param jsonBody body of the request in json format
+     * @param headers additional headers
+     * @returns false, if another request is still running
+     */
+    bool startRequest(const String& urlWithoutHost, const String& jsonBody, const headers_t& headers);
+
+    /**
+     * Advances the running request without waiting
+     * @returns state of the request
+     */
+    State process();
+
+    /**
+     * Processes the running request until it is finished
+     * @returns DONE or FAILED
+     */
+    State waitForResponse();
+
+    /**
+     * Releases a finished request, must be called after DONE or FAILED
+     */
+    void finish() { _state = IDLE; }
+
+    /**
+     * Closes the tcp connection
+     */
+    void close();
+
+    bool isIdle() const { return _state == IDLE; }
+    int getStatusCode() const { return _statusCode; }
+    const String& getResponse() const { return _response; }
+
+private:
+    enum ResponsePart { STATUS_LINE, HEADER_LINE, BODY, CHUNK_SIZE, CHUNK_DATA, CHUNK_END };
+
+    /**
+     * Opens the tcp connection, if it is not open
+     * @returns true, if connected
+     */
+    bool open();
+
+    /**
+     * Writes the part of the request fitting into the send buffer
+     */
+    void send();
+
+    /**
+     * Reads and parses the available part of the response
+     */
+    void receive();
+
+    /**
+     * Handles a complete status or header line
+     */
+    void handleLine();
+
+    /**
+     * Ends the request with a failure. A request on a reused connection closed by the broker 
+     * before answering is repeated once on a new connection.
+     */
+    void fail();
+
+    /**
+     * Ends the request successfully
+     */
+    void complete();
+
+    String _host;
+    uint16_t _port;
+    WiFiClient _client;
+    State _state;
+    uint32_t _startTime;
+
+    String _head;
+    String _body;
+    uint16_t _written;
+    bool _isReused;
+    bool _isRepeated;
+
+    ResponsePart _part;
+    String _line;
+    String _response;
+    int _statusCode;
+    int32_t _remaining;
+    bool _hasLength;
+    bool _isChunked;
+    bool _closeAfterResponse;
+};
@@ -14,12 +14,11 @@
 #include <debug.h>
 #include <eepromaccess.h>
 #include <ESP8266WiFi.h>
-#include <WiFiClient.h>
-#include <ESP8266HTTPClient.h>
 #include <map>
 #include "brokerproxy.h"
 #include "json.h"
-
+#include "jsonwriter.h"
+#include <profiler.h>
 
 BrokerProxy::Configuration::Configuration() {
     brokerHost = "192.168.0.1";
@@ -29,41 +28,25 @@ BrokerProxy::Configuration::Configuration() {
     subscribeTo = "";
 }
 
-std::map<String, String> BrokerProxy::Configuration::get()
+Properties BrokerProxy::Configuration::get()
 {
-    std::map<String, String> result;
-    result["broker/host"] = brokerHost;
-    result["broker/port"] = brokerPort;
-    result["broker/clientName"] = clientName;
-    result["broker/baseTopic"] = baseTopic;
-    result["broker/subscribeTo"] = subscribeTo;
+    Properties result;
+    result.set(StaticKey("broker/host"), brokerHost);
+    result.set(StaticKey("broker/port"), brokerPort);
+    result.set(StaticKey("broker/clientName"), clientName);
+    result.set(StaticKey("broker/baseTopic"), baseTopic);
+    result.set(StaticKey("broker/subscribeTo"), subscribeTo);
     return result;
 }
 
-void BrokerProxy::Configuration::set(jsonObject_t& config)
+void BrokerProxy::Configuration::set(const Properties& config)
 {
-    brokerHost = config["broker/host"];
-    brokerPort = config["broker/port"];
-    clientName = config["broker/clientName"];
-    baseTopic = config["broker/baseTopic"];
-    subscribeTo = config["broker/subscribeTo"];
-}
-
-const char* BrokerProxy::htmlForm = R"htmlform(
-    <form action="/broker" method="POST">
-    <label for="brokerhost">Broker host</label>
-    <input type="text" id="brokerhost" name="broker/host" placeholder="Broker host..." [value]="broker/host">
-    <label for="brokerport">Broker port</label>
-    <input type="number" id="brokerport" name="broker/port" [value]="broker/port">
-    <label for="clientname">Client name</label>
-    <input type="text" id="clientname" name="broker/clientName" [value]="broker/clientName">
-    <label for="basetopic">Base topic</label>
-    <input type="text" id="basetopic" name="broker/baseTopic" [value]="broker/baseTopic">
-    <label for="subscribeto">Subscribe topic</label>
-    <input type="text" id="subscribeto" name="broker/subscribeTo" [value]="broker/subscribeTo">
-    <input type="submit" value="Submit">
-    </form>
-    )htmlform";
+    brokerHost = config.get("broker/host");
+    brokerPort = config.get("broker/port");
+    clientName = config.get("broker/clientName");
+    baseTopic = config.get("broker/baseTopic");
+    subscribeTo = config.get("broker/subscribeTo");
+}
 
 uint16_t BrokerProxy::writeConfigToEEPROM(uint16_t EEPROMAddress) {
     EEPROMAccess::write(EEPROMAddress, (uint8_t*) &_config, sizeof(_config));
@@ -75,42 +58,47 @@ uint16_t BrokerProxy::readConfigFromEEPROM(uint16_t EEPROMAddress) {
     return EEPROMAddress + sizeof(_config);
 }
 
-String BrokerProxy::sendToServer(String urlWithoutHost, String jsonBody, headers_t headers) {
-    WiFiClient client;
-    HTTPClient http;
-    String url = String("http://") + _config.brokerHost + ":" + _config.brokerPort + urlWithoutHost;
+void BrokerProxy::setServer() {
+    _connection.setServer(_config.brokerHost.getBuffer(), atoi(_config.brokerPort.getBuffer()));
+}
+
+String BrokerProxy::sendToServer(const String& urlWithoutHost, const String& jsonBody, const headers_t& headers, int* httpCodeResult) {
+    String response;
+    int httpCode = BrokerConnection::HTTP_ERROR;
     
-    PRINT_IF_DEBUG(url);
+    PRINT_IF_DEBUG(urlWithoutHost);
     PRINT_IF_DEBUG(" ");
     PRINT_VARIABLE_IF_DEBUG(jsonBody);
-    
-    delay(5);
-    
-    http.begin(client, url);
-    http.addHeader("Content-Type", "application/json");
-    http.addHeader("cache-control", "no-cache");
-    http.addHeader("version", "1.0");
-    for (auto const& header: headers) {
-        http.addHeader(header.first, header.second);
+
+    while (_queue.getInFlight() > 0) {
+        processQueue();
+        yield();
+    }
+    setServer();
+    _connection.startRequest(urlWithoutHost, jsonBody, headers);
+    if (_connection.waitForResponse() == BrokerConnection::DONE) {
+        httpCode = _connection.getStatusCode();
+        response = _connection.getResponse();
     }
+    _connection.finish();
 
-    uint16_t httpCode = http.PUT(jsonBody);
     PRINTLN_VARIABLE_IF_DEBUG(httpCode);
-    String response = http.getString();
-
     if (httpCode != 204) {
         PRINTLN_VARIABLE_IF_DEBUG(response)
     }
-
-    http.end();
-    delay(10);
+    if (httpCodeResult != 0) {
+        *httpCodeResult = httpCode;
+    }
     return response;
 }
 
 void BrokerProxy::storeToken(const String& response) {
     JSON jsonResponse(response);
-    _sendToken = jsonResponse.getElement("token.send");
-    _receiveToken = jsonResponse.getElement("token.receive");
+    const char* paths[] = { "token.send", "token.receive" };
+    JSONSpan spans[2];
+    jsonResponse.getElements(paths, spans);
+    _sendToken = jsonResponse.getString(spans[0]);
+    _receiveToken = jsonResponse.getString(spans[1]);
     PRINTLN_VARIABLE_IF_DEBUG(_sendToken)
     PRINTLN_VARIABLE_IF_DEBUG(_receiveToken)
 }
@@ -120,16 +108,21 @@ void BrokerProxy::connect(const String& port) {
         return;
     }
     String host = WLAN::getLocalIP();
-    String body = "{" + 
-        jsonStringProperty("clientId", _config.clientName) + "," + 
-        jsonStringProperty("clean", "false") + "," + 
-        jsonStringProperty("host", host) + "," + 
-        jsonStringProperty("port", port) + "," +
-        jsonStringProperty("clean", "false") + "," + 
-        jsonStringProperty("keepAlive", "100000") + "}";
+    String body = jsonToString([&](JSONWriter& json) {
+        json.beginObject()
+            .property("clientId", _config.clientName.getBuffer())
+            .property("clean", "false")
+            .property("host", host)
+            .property("port", port)
+            .property("keepAlive", "100000")
+        .endObject();
+    });
     String urlWithoutHost = "/connect";
+    Profiler::begin(Profiler::BROKER_CONNECT);
     String response = sendToServer(urlWithoutHost, body);
+    Profiler::end(Profiler::BROKER_CONNECT);
     storeToken(response);
+    Profiler::Scope profilerScope(Profiler::SUBSCRIBE);
     subscribe(String(_config.baseTopic) + "/+/+/set", 1);
     if (_config.subscribeTo != "") {
         subscribe(_config.subscribeTo, 1);
@@ -137,45 +130,105 @@ void BrokerProxy::connect(const String& port) {
 }
 
 void BrokerProxy::disconnect() {
+    if (!WLAN::isConnected()) {
+        return;
+    }
     PRINTLN_IF_DEBUG("BrokerProxy::disconnect()")
-    String body = "{" + jsonStringProperty("clientId", _config.clientName) + "}";
+    String body = jsonToString([&](JSONWriter& json) {
+        json.beginObject().property("clientId", _config.clientName.getBuffer()).endObject();
+    });
     String urlWithoutHost = "/disconnect";
     sendToServer(urlWithoutHost, body);
+    _connection.close();
     PRINTLN_IF_DEBUG("BrokerProxy::disconnect() finished")
 }
 
 void BrokerProxy::subscribe(String topic, uint8_t qos) {
-    String body = "{" + 
-        jsonStringProperty("clientId", _config.clientName) + "," + 
-        jsonObjectProperty("subscribe", "{" + 
-            jsonStringProperty("QoS", String(qos)) + "," + 
-            jsonStringProperty("topics", topic) 
-            + "}")
-        + "}";
-
-    String bodyV1 = "{" +
-        jsonStringProperty("clientId", _config.clientName) + "," + 
-        jsonObjectProperty("subscribe", "{" + 
-            jsonStringProperty(topic, String(qos)) + "}" )
-        + "}";
+    String body = jsonToString([&](JSONWriter& json) {
+        json.beginObject()
+            .property("clientId", _config.clientName.getBuffer())
+            .beginObject("subscribe")
+                .property(topic.c_str(), String(qos))
+            .endObject()
+        .endObject();
+    });
         
     String urlWithoutHost = "/subscribe";
     PRINT_IF_DEBUG("Subscribe: ")
-    PRINTLN_IF_DEBUG(bodyV1)
-    sendToServer(urlWithoutHost, bodyV1);
+    PRINTLN_IF_DEBUG(body)
+    sendToServer(urlWithoutHost, body);
 }
 
-void BrokerProxy::publishMessage(const Message& message, bool retain) {
-    String body = message.toPublishString();
-    String urlWithoutHost = "/publish";
-    headers_t headers;
-    headers["qos"] = "0";
-    headers["retain"] = retain ? "1" : "0";
-    sendToServer(urlWithoutHost, body, headers);
+void BrokerProxy::publishMessage(const Message& message, bool retain, uint8_t qos) {
+    _queue.push(message, qos, retain);
 }
 
-void BrokerProxy::publishMessages(const Messages_t& messages, bool retain) {
+void BrokerProxy::publishMessages(const Messages_t& messages, bool retain, uint8_t qos) {
     for (auto const& message: messages) {
-        publishMessage(message, retain);
+        _queue.push(message, qos, retain);
+    }
+}
+
+void BrokerProxy::startQueuedRequest() {
+    uint8_t amount = _queue.getBatchSize(_isBatchSupported ? MAX_BATCH_SIZE : 1);
+    const QueuedMessage& first = _queue.at(0);
+    headers_t headers;
+    headers["qos"] = String(first.qos);
+    headers["retain"] = first.retain ? "1" : "0";
+    _isInFlightBatch = amount > 1;
+    String body;
+    if (_isInFlightBatch) {
+        body = jsonToString([this, amount](JSONWriter& json) {
+            json.beginArray();
+            for (uint8_t index = 0; index < amount; index++) {
+                _queue.at(index).message.writeTo(json);
+            }
+            json.endArray();
+        });
+    } else {
+        body = first.message.toPublishString();
+    }
+    setServer();
+    if (_connection.startRequest(_isInFlightBatch ? "/publish/batch" : "/publish", body, headers)) {
+        _queue.setInFlight(amount);
+    }
+}
+
+void BrokerProxy::processQueue() {
+    if (_queue.getInFlight() == 0) {
+        if (_queue.isEmpty() || !WLAN::isConnected()) {
+            return;
+        }
+        startQueuedRequest();
+        if (_queue.getInFlight() == 0) {
+            return;
+        }
+    }
+    BrokerConnection::State state = _connection.process();
+    if (state != BrokerConnection::DONE && state != BrokerConnection::FAILED) {
+        return;
+    }
+    int httpCode = state == BrokerConnection::DONE ? _connection.getStatusCode() : BrokerConnection::HTTP_ERROR;
+    _connection.finish();
+    if (httpCode >= 200 && httpCode < 300) {
+        _queue.pop(_queue.getInFlight());
+    } else if (_isInFlightBatch && isNotSupported(httpCode)) {
+        // The messages stay in the queue and are sent one by one, other errors are retried
+        PRINTLN_IF_DEBUG("Broker does not support batch publish, sending single messages")
+        _isBatchSupported = false;
+    } else {
+        PRINT_IF_DEBUG("Publish failed ")
+        PRINTLN_VARIABLE_IF_DEBUG(httpCode)
+        _queue.failed(_queue.getInFlight());
+    }
+    _queue.setInFlight(0);
+}
+
+bool BrokerProxy::flush(uint32_t timeout) {
+    uint32_t start = millis();
+    while ((_queue.getInFlight() > 0 || !_queue.isEmpty()) && WLAN::isConnected() && millis() - start < timeout) {
+        processQueue();
+        yield();
     }
+    return _queue.getInFlight() == 0 && _queue.isEmpty();
 }
@@ -14,11 +14,12 @@
 #include <Arduino.h>
 #include <map>
 #include <idevice.h>
+#include <assets.h>
 #include "staticstring.h"
 #include "message.h"
 #include "wlan.h"
-
-typedef std::map<String, String> headers_t;
+#include "brokerconnection.h"
+#include "publishqueue.h"
 
 class BrokerProxy : public IDevice {
 public:
@@ -35,28 +36,32 @@ public:
         /**
          * Gets the configuration as key/value map
          */
-        std::map<String, String> get();
+        Properties get();
 
         /**
          * Sets the configuration from a key/value map
          * @param config configuration settings in a map
          */
-        void set(jsonObject_t& config);
+        void set(const Properties& config);
     };
 
-    BrokerProxy() {};
+    /**
+     * @param queueDepth maximal amount of messages waiting to be published
+     */
+    BrokerProxy(uint8_t queueDepth = PublishQueue::DEFAULT_DEPTH) 
+        : _queue(queueDepth), _isInFlightBatch(false), _isBatchSupported(true), _isFlushed(false) {};
     
     /**
      * Sets the configuration
      */
-    virtual void setConfig(jsonObject_t& config) {
+    virtual void setConfig(const Properties& config) {
         _config.set(config);
     }
 
     /**
      * Gets the configuration
      */
-    virtual jsonObject_t getConfig() { return _config.get(); }
+    virtual Properties getConfig() { return _config.get(); }
 
     /**
      * Writes the configuration to EEPROM
@@ -75,17 +80,21 @@ public:
     /**
      * Gets an info about the matching html page
      */
-    virtual HtmlPageInfo getHtmlPage() { return HtmlPageInfo(htmlForm, "/broker", "Broker"); }
+    virtual HtmlPageInfo getHtmlPage() { return HtmlPageInfo(brokerForm, "/broker", "Broker"); }
 
     /**
-     * Connect to the broker
+     * Sends the queued messages and disconnects from broker
      */
-    virtual void setup() { connect(); }
+    virtual void closeDown() { 
+        _isFlushed = WLAN::isConnected() && flush(FLUSH_TIMEOUT) && _queue.getDroppedAmount() == 0;
+        disconnect(); 
+    }
 
     /**
-     * Disconnects from broker
+     * @returns true, if closeDown delivered all queued messages to the broker and no message was 
+     * dropped since start
      */
-    virtual void closeDown() { disconnect(); }
+    bool isFlushed() const { return _isFlushed; }
 
     /**
      * Connects to the yaha "near-mqtt" broker
@@ -105,18 +114,46 @@ public:
     void subscribe(String topic, uint8_t qos);
 
     /**
-     * Publishes a message to the broker
+     * Queues a message for publishing, the message is sent by processQueue
      * @param message message to publish
      * @param retain if true, the broker will retain the message
+     * @param qos 0 sends the message at most once, 1 repeats it until the broker accepts it
      */
-    void publishMessage(const Message& message, bool retain = false);
+    void publishMessage(const Message& message, bool retain = false, uint8_t qos = 0);
 
     /**
-     * Publishes several messages to the broker
+     * Queues several messages for publishing. Messages are sent as JSON array in one request
+     * per MAX_BATCH_SIZE messages. If the broker rejects a batch, messages are sent one by one 
+     * and batches are not used any more.
      * @param message messages to publish
      * @param retain if true, the broker will retain the messages
+     * @param qos 0 sends the messages at most once, 1 repeats them until the broker accepts them
+     */
+    void publishMessages(const Messages_t& messages, bool retain = false, uint8_t qos = 0);
+
+    /**
+     * Sets the function called for every message accepted by the broker
+     * @param delivered function to call
+     */
+    void setDeliveredFunction(PublishQueue::Delivered_t delivered) { _queue.setDeliveredFunction(delivered); }
+
+    /**
+     * Sends queued messages without waiting for the broker. Call it frequently from the loop.
+     */
+    void processQueue();
+
+    /**
+     * Processes the queue until it is empty
+     * @param timeout maximal time to wait in milliseconds
+     * @returns true, if all messages are sent
+     */
+    bool flush(uint32_t timeout);
+
+    /**
+     * Sets the maximal amount of messages waiting to be published, the oldest messages are 
+     * dropped if more messages are queued
      */
-    void publishMessages(const Messages_t& messages, bool retain = false);
+    void setQueueDepth(uint8_t depth) { _queue.setDepth(depth); }
 
     /**
      * Gets the base topic for sending messages to the broker
@@ -124,14 +161,35 @@ public:
     String getBaseTopic() { return _config.baseTopic; }
 
 private:
+    static const uint8_t MAX_BATCH_SIZE = 16;
+    static const uint32_t FLUSH_TIMEOUT = 3000;
+
+    /**
+     * Updates the broker address of the connection from the configuration
+     */
+    void setServer();
+
+    /**
+     * Starts a request for the messages at the front of the queue
+     */
+    void startQueuedRequest();
+
     /**
-     * Sends an info to the mqtt broker
+     * @returns true, if the broker answers that it does not provide an endpoint (404, 405, 501)
+     */
+    static bool isNotSupported(int httpCode) { return httpCode == 404 || httpCode == 405 || httpCode == 501; }
+
+    /**
+     * Sends an info to the mqtt broker and waits for the answer. A running queued request is 
+     * finished first, as both share the keep-alive connection.
      * @param urlWithoutHost url 
      * @param jsonBody body of the message in json format
      * @param headers list of headers
+     * @param httpCode receives the http status code, if not 0
      * @returns answer string
      */
-    String sendToServer(String urlWithoutHost, String jsonBody, headers_t headers = headers_t()); 
+    String sendToServer(const String& urlWithoutHost, const String& jsonBody, 
+        const headers_t& headers = headers_t(), int* httpCode = 0); 
 
     /**
      * Stores the token from a connect response string
@@ -139,12 +197,14 @@ private:
      */
     void storeToken(const String& response);
 
-    static const char* htmlForm;
-
     Configuration _config;
+    BrokerConnection _connection;
+    PublishQueue _queue;
+    bool _isInFlightBatch;
     String _IPAddress;
     String _port;
     String _sendToken;
     String _receiveToken;
-
+    bool _isBatchSupported;
+    bool _isFlushed;
 };
\ No newline at end of file
@@ -0,0 +1,57 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ */
+
+#define __DEBUG
+#include "debug.h"
+#include "chunkedwriter.h"
+
+ChunkedWriter::ChunkedWriter(ESP8266WebServer& server, int code, const char* contentType) 
+    : _server(server), _length(0), _isEnded(false) 
+{
+    _server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    _server.send(code, contentType, "");
+}
+
+size_t ChunkedWriter::write(const uint8_t* buffer, size_t size) {
+    size_t written = 0;
+    while (written < size) {
+        if (_length == BUFFER_SIZE) {
+            flush();
+        }
+        size_t amount = size - written;
+        if (amount > size_t(BUFFER_SIZE - _length)) {
+            amount = BUFFER_SIZE - _length;
+        }
+        memcpy(_buffer + _length, buffer + written, amount);
+        _length += amount;
+        written += amount;
+    }
+    return written;
+}
+
+void ChunkedWriter::writeP(PGM_P content) {
+    // Large static parts are sent as own chunk directly from flash
+    flush();
+    _server.sendContent_P(content);
+}
+
+void ChunkedWriter::flush() {
+    if (_length > 0) {
+        _server.sendContent(_buffer, _length);
+        _length = 0;
+    }
+}
+
+void ChunkedWriter::end() {
+    if (!_isEnded) {
+        flush();
+        _server.sendContent("");
+        _isEnded = true;
+    }
+}
@@ -0,0 +1,63 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Provides a Print streaming a http response in chunks
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+
+/**
+ * Streams a http response with chunked transfer encoding. Small writes are collected in a fixed 
+ * buffer, thus the heap needed does not depend on the size of the response.
+ */
+class ChunkedWriter : public Print {
+public:
+    static const uint16_t BUFFER_SIZE = 256;
+
+    /**
+     * Sends the http header, the content is sent by the write functions
+     * @param server web server handling the current request
+     * @param code http status code
+     * @param contentType content type of the response
+     */
+    ChunkedWriter(ESP8266WebServer& server, int code, const char* contentType);
+
+    /**
+     * Sends the last chunk, if end was not called
+     */
+    ~ChunkedWriter() { end(); }
+
+    virtual size_t write(uint8_t ch) { return write(&ch, 1); }
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    using Print::write;
+
+    /**
+     * Writes a string stored in flash without copying it to RAM
+     * @param content zero terminated string in PROGMEM
+     */
+    void writeP(PGM_P content);
+
+    /**
+     * Sends the buffered content as one chunk
+     */
+    virtual void flush();
+
+    /**
+     * Sends the remaining content and the terminating chunk
+     */
+    void end();
+
+private:
+    ESP8266WebServer& _server;
+    char _buffer[BUFFER_SIZE];
+    uint16_t _length;
+    bool _isEnded;
+};
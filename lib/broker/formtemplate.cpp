@@ -0,0 +1,67 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ */
+
+#define __DEBUG
+#include "debug.h"
+#include "hash.h"
+#include "formtemplate.h"
+
+FormTemplate::FormTemplate(PGM_P form) : _form(form), _length(strlen_P(form)) {
+    _hash = hashP(_form, _length);
+    for (uint16_t pos = 0; pos < _length; pos++) {
+        if (pgm_read_byte(_form + pos) != '[') {
+            continue;
+        }
+        if (parseSlot(pos, "[value]=\"", VALUE) || parseSlot(pos, "[checked]=\"", CHECKED)) {
+            pos = _slots.back().next - 1;
+        }
+    }
+}
+
+bool FormTemplate::parseSlot(uint16_t pos, const char* name, SlotType type) {
+    uint16_t nameLength = strlen(name);
+    if (pos + nameLength > _length || strncmp_P(name, _form + pos, nameLength) != 0) {
+        return false;
+    }
+    uint16_t keyEnd = pos + nameLength;
+    while (keyEnd < _length && pgm_read_byte(_form + keyEnd) != '"') {
+        keyEnd++;
+    }
+    if (keyEnd == _length) {
+        return false;
+    }
+    Slot slot;
+    slot.literalEnd = pos;
+    slot.key = _keys.size();
+    slot.type = type;
+    slot.next = keyEnd + 1;
+    for (uint16_t i = pos + nameLength; i < keyEnd; i++) {
+        _keys.push_back(pgm_read_byte(_form + i));
+    }
+    _keys.push_back(0);
+    _slots.push_back(slot);
+    return true;
+}
+
+void FormTemplate::render(const Properties& data, Print& out) const {
+    uint16_t pos = 0;
+    for (auto const& slot: _slots) {
+        out.write_P(_form + pos, slot.literalEnd - pos);
+        PropertyValue value = data.get(&_keys[slot.key]);
+        if (slot.type == VALUE) {
+            out.print("value=\"");
+            out.print(value.c_str());
+            out.print('"');
+        } else if (value == "on") {
+            out.print("checked=\"checked\"");
+        }
+        pos = slot.next;
+    }
+    out.write_P(_form + pos, _length - pos);
+}
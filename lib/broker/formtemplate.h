@@ -0,0 +1,70 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Provides html forms with placeholders filled from properties
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include <properties.h>
+
+/**
+ * Html form stored in flash and parsed once into literal text and placeholder slots. Only the
+ * placeholder keys are copied to RAM. Supported placeholders:
+ * [value]="key" is replaced by value="<value of key>"
+ * [checked]="key" is replaced by checked="checked", if the value of key is "on"
+ */
+class FormTemplate {
+public:
+    FormTemplate() : _form(0), _length(0), _hash(0) {}
+
+    /**
+     * Parses a form
+     * @param form html form with placeholders in PROGMEM
+     */
+    FormTemplate(PGM_P form);
+
+    /**
+     * Renders the form in one pass, each placeholder is resolved by one lookup
+     * @param data values for the placeholders
+     * @param out output the form is written to
+     */
+    void render(const Properties& data, Print& out) const;
+
+    /**
+     * @returns hash of the form text
+     */
+    uint32_t getHash() const { return _hash; }
+
+private:
+    enum SlotType { VALUE, CHECKED };
+
+    /**
+     * A placeholder with the literal text in front of it
+     */
+    struct Slot {
+        uint16_t literalEnd;
+        uint16_t key;
+        SlotType type;
+        uint16_t next;
+    };
+
+    /**
+     * Tries to read a placeholder at a position
+     * @returns true, if a placeholder starts at pos
+     */
+    bool parseSlot(uint16_t pos, const char* name, SlotType type);
+
+    PGM_P _form;
+    uint16_t _length;
+    uint32_t _hash;
+    std::vector<Slot> _slots;
+    std::vector<char> _keys;
+};
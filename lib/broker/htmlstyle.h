@@ -1,5 +0,0 @@
-#pragma once
-
-const char* htmlStyle = R"htmlstyle(
-<link rel="stylesheet" type="text/css" href="css.css">    
-)htmlstyle";
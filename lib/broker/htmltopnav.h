@@ -1,11 +0,0 @@
-#pragma once
-
-const char* htmlTopNav = R"topnav(
-<div class="topnav">
-<a href="/">Home</a>
-<a href="/wlan">Wlan</a>
-<a href="/broker">Broker</a>
-<a href="/client">Client</a>
-<a href="/battery">Battery</a>
-</div>
-)topnav";
@@ -6,224 +6,299 @@
 * @author Volker B�hm
 * @copyright Copyright (c) 2020 Volker B�hm
 * @brief
-* Provides a class to connect to WLAN
+* Reads values from a JSON formatted string by a JSON path without copying it
 */
 
 #define __DEBUG
 #include "debug.h"
 #include "json.h"
-#include "jsontokenizer.h"
 
 /**
-* Creates a json property string
-* @param name property name
-* @param value property string value
-*/
-String jsonStringProperty(String name, String value) {
-	return String("\"" + name + "\": \"" + value + "\"");
-}
+ * Output of decodeValue writing to a fixed size buffer
+ */
+class BufferSink {
+public:
+	BufferSink(char* buffer, uint16_t bufferSize) : _buffer(buffer), _bufferSize(bufferSize), _length(0) {}
+	void add(char ch) {
+		if (_length + 1 < _bufferSize) {
+			_buffer[_length] = ch;
+		}
+		_length++;
+	}
+	bool terminate() {
+		if (_bufferSize == 0) {
+			return false;
+		}
+		_buffer[_length < _bufferSize ? _length : _bufferSize - 1] = 0;
+		return _length < _bufferSize;
+	}
+private:
+	char* _buffer;
+	uint16_t _bufferSize;
+	uint16_t _length;
+};
 
 /**
-* Creates a json object property string
-* @param name property name
-* @param object json definition of an object or array or non-string value as string
-*/
-String jsonObjectProperty(String name, String object) {
-	return String("\"" + name + "\": " + object);
-}
+ * Output of decodeValue appending to a string with reserved memory
+ */
+class StringSink {
+public:
+	StringSink(String& result) : _result(result) {}
+	void add(char ch) { _result += ch; }
+private:
+	String& _result;
+};
 
-String unquote(const String& quotedString) {
-    String result;
-    if (quotedString.charAt(0) == '"' && quotedString.charAt(quotedString.length() - 1) == '"') {
-		result = quotedString.substring(1, quotedString.length() - 1);
-	} else {
-        result = quotedString;
-    }
-    return result;
+/**
+ * Converts a hex digit to its value
+ */
+static uint8_t hexValue(char ch) {
+	if (ch >= '0' && ch <= '9') return ch - '0';
+	if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+	if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+	return 0;
 }
 
 /**
-  * Gets the content of an array
-  * @param json string tokenizer
-  * @returns Array content
-  */
-String JSON::getArrayContent(JSONTokenizer& json) const {
-	String object = getNextObject(json);
-	String result = "";
-	String tk;
-	while (object != "" && object != "]") {
-		result += object;
-		tk = json.getNextToken();
-		if (tk == "") {
-			break;
+ * Decodes a value, strings are unquoted and unescaped, other values are copied
+ * @param value pointer to the first character of the value
+ * @param length raw length of the value
+ * @param sink output receiving the decoded characters
+ */
+template<class Sink>
+static void decodeValue(const char* value, uint16_t length, Sink& sink) {
+	if (length < 2 || value[0] != '"') {
+		for (uint16_t i = 0; i < length; i++) {
+			sink.add(value[i]);
 		}
-		else if (tk == ",") {
-			result += tk;
-			object = getNextObject(json);
+		return;
+	}
+	const char* end = value + length - 1;
+	for (const char* pos = value + 1; pos < end; pos++) {
+		if (*pos != '\\' || pos + 1 >= end) {
+			sink.add(*pos);
+			continue;
 		}
-		else if (tk == "]") {
-			break;
-		} else {
-			json.setError(", or ]");
+		pos++;
+		switch (*pos) {
+			case 'b': sink.add('\b'); break;
+			case 'f': sink.add('\f'); break;
+			case 'n': sink.add('\n'); break;
+			case 'r': sink.add('\r'); break;
+			case 't': sink.add('\t'); break;
+			case 'u': {
+				uint16_t code = 0;
+				for (uint8_t i = 0; i < 4 && pos + 1 < end; i++) {
+					pos++;
+					code = (code << 4) | hexValue(*pos);
+				}
+				if (code < 0x80) {
+					sink.add(char(code));
+				} else if (code < 0x800) {
+					sink.add(char(0xC0 | (code >> 6)));
+					sink.add(char(0x80 | (code & 0x3F)));
+				} else {
+					sink.add(char(0xE0 | (code >> 12)));
+					sink.add(char(0x80 | ((code >> 6) & 0x3F)));
+					sink.add(char(0x80 | (code & 0x3F)));
+				}
+				break;
+			}
+			default: sink.add(*pos); break;
 		}
 	}
-	result += tk;
-	return result;
 }
 
 /**
-* Gets the content of an array
-* @param json string tokenizer
-* @returns Array content
-*/
-String JSON::getObjectContent(JSONTokenizer& json) const {
-	String propertyName = json.getNextToken();
-	String result = propertyName;
-	while (propertyName != "}" && propertyName != "") {
-		result += json.skipExpectedToken(":");
-		result += getNextObject(json);
-		String tk = json.getNextToken();
-		if (tk == "}") {
-			result += tk;
-			break;
-		}
-		else if (tk == ",") {
-			result += tk;
-			propertyName = json.getNextToken();
-			result += propertyName;
-		}
-		else {
-			json.setError(", or  }");
-		}
+ * Matches the next segment of a path with a property name
+ * @param path current position in the path
+ * @param name property name (not terminated)
+ * @param nameLength length of the property name
+ * @returns position in the path behind the segment or 0, if the segment does not match
+ */
+static const char* matchName(const char* path, const char* name, uint16_t nameLength) {
+	if (*path == '.') {
+		path++;
 	}
-	return result;
+	if (*path == '[' || strncmp(path, name, nameLength) != 0) {
+		return 0;
+	}
+	path += nameLength;
+	return (*path == 0 || *path == '.' || *path == '[') ? path : 0;
 }
 
 /**
- * Gets the next object of a json
- * @param json string tokenizer
+ * Matches the next segment of a path with an array index
+ * @param path current position in the path
+ * @param index index of the array element
+ * @returns position in the path behind the segment or 0, if the segment does not match
  */
-String JSON::getNextObject(JSONTokenizer& json) const {
-	String tk = json.getNextToken();
-	String result = tk;
-	if (tk == "{") {
-		result += getObjectContent(json);
-	}
-	else if (tk == "[") {
-		result += getArrayContent(json);
-	}
-	else if (tk == "]" || tk == "}") {
-		return tk;
-	} 
-	return result;
+static const char* matchIndex(const char* path, uint16_t index) {
+	if (*path != '[') {
+		return 0;
+	}
+	uint16_t pathIndex = 0;
+	for (path++; *path >= '0' && *path <= '9'; path++) {
+		pathIndex = pathIndex * 10 + *path - '0';
+	}
+	if (*path == ']') {
+		path++;
+	}
+	return pathIndex == index ? path : 0;
 }
 
-
-/**
-* Gets a property from a json object
-* @param json string tokenizer
-* @param property property name
-* @returns true, if found
-*/
-bool JSON::searchPropertyInObject(JSONTokenizer& json, const String& property) const {
-	String tk;
-	bool result = false;
-	json.skipExpectedToken("{");
-	tk = json.getNextToken();
-	while (tk != "}") {
-		json.skipExpectedToken(":");
-		if (tk == "\"" + property + "\"") {
-			result = true;
-			break;
+void JSON::resolvePaths(JSONTokenizer& tokenizer, const JSONToken& token, const char** paths, 
+	uint32_t open, JSONSpan* spans, uint8_t& remaining) const 
+{
+	uint32_t ending = 0;
+	for (uint8_t i = 0; i < MAX_PATHS; i++) {
+		const uint32_t bit = uint32_t(1) << i;
+		if ((open & bit) && (*paths[i] == 0 || (*paths[i] == '.' && paths[i][1] == 0))) {
+			ending |= bit;
 		}
-		getNextObject(json);
-		tk = json.getNextToken();
-		if (tk == ",") {
-			tk = json.getNextToken();
-		} else if (tk != "}") {
-			json.setError("} or ,");
-			break;
+	}
+	open &= ~ending;
+	const bool isObject = token.type == JSON_BEGIN_OBJECT;
+	if (open == 0 || (!isObject && token.type != JSON_BEGIN_ARRAY)) {
+		if (!tokenizer.skipValue(token)) {
+			return;
+		}
+	} else {
+		const JSONTokenType closing = isObject ? JSON_END_OBJECT : JSON_END_ARRAY;
+		JSONToken member = tokenizer.next();
+		for (uint16_t index = 0; member.type != closing; index++) {
+			JSONToken name = member;
+			if (isObject) {
+				if (name.type != JSON_STRING || tokenizer.next().type != JSON_COLON) {
+					return;
+				}
+				member = tokenizer.next();
+			}
+			uint32_t matching = 0;
+			for (uint8_t i = 0; i < MAX_PATHS && open != 0; i++) {
+				const uint32_t bit = uint32_t(1) << i;
+				if (open & bit) {
+					const char* next = isObject ? 
+						matchName(paths[i], _json + name.begin + 1, name.len - 2) : matchIndex(paths[i], index);
+					if (next != 0) {
+						paths[i] = next;
+						matching |= bit;
+					}
+				}
+			}
+			if (matching != 0) {
+				resolvePaths(tokenizer, member, paths, matching, spans, remaining);
+				// Paths matching this member are either resolved now or not part of the document
+				open &= ~matching;
+				if (remaining == 0) {
+					return;
+				}
+			} else if (!tokenizer.skipValue(member)) {
+				return;
+			}
+			JSONToken separator = tokenizer.next();
+			if (separator.type == JSON_COMMA) {
+				member = tokenizer.next();
+			} else if (separator.type != closing) {
+				return;
+			} else {
+				break;
+			}
+		}
+	}
+	if (tokenizer.hasError()) {
+		return;
+	}
+	for (uint8_t i = 0; i < MAX_PATHS && ending != 0; i++) {
+		const uint32_t bit = uint32_t(1) << i;
+		if (ending & bit) {
+			spans[i].offset = token.begin;
+			spans[i].length = tokenizer.getPos() - token.begin;
+			ending &= ~bit;
+			remaining--;
 		}
 	}
-	return result;
 }
 
-/**
-* Gets a property from a json object
-* @param json string tokenizer
-* @param property property name
-* @returns true, if found
-*/
-bool JSON::searchArrayElement(JSONTokenizer& json, uint16_t index) const {
-	json.skipExpectedToken("[");
-	String tk;
-	while (index > 0 && tk != "]") {
-		getNextObject(json);
-		tk = json.getNextToken();
-		if (tk == ",") {
-			index--;
-		} else if (tk != "]") {
-			json.setError("] or ,");
-			break;
-		} 
+uint8_t JSON::getElements(const char* const* jsonPaths, JSONSpan* spans, uint8_t count) const {
+	const char* paths[MAX_PATHS];
+	uint32_t open = 0;
+	if (count > MAX_PATHS) {
+		count = MAX_PATHS;
 	}
-	return index == 0;
+	for (uint8_t i = 0; i < count; i++) {
+		paths[i] = jsonPaths[i];
+		spans[i] = JSONSpan();
+		open |= uint32_t(1) << i;
+	}
+	uint8_t remaining = count;
+	JSONTokenizer tokenizer(_json, _length);
+	JSONToken token = tokenizer.next();
+	resolvePaths(tokenizer, token, paths, open, spans, remaining);
+	return count - remaining;
 }
 
+bool JSON::findElement(const char* jsonPath, JSONSpan& span) const {
+	return getElements(&jsonPath, &span, 1) == 1 && span.isFound();
+}
 
-/**
-* Recursively extracts a substring from a json string by following the path
-* @param json string in JSON format
-* @param path string in json path format
-*/
-String JSON::getElementRec(JSONTokenizer& json, JSONTokenizer& path) const {
-	String pathChunk = path.getNextToken();
-	String result = "";
-	if (pathChunk == ".") {
-		pathChunk = path.getNextToken();
-	}
-	if (pathChunk == "") {
-		result = getNextObject(json);
-	}
-	else if (pathChunk == "[") {
-		String indexString = path.getNextToken();
-		uint16_t index = indexString.toInt();
-		path.skipExpectedToken("]");
-		if (searchArrayElement(json, index)) {
-			result = getElementRec(json, path);
-		}
-	}
-	else {
-		if (searchPropertyInObject(json, pathChunk)) {
-			result = getElementRec(json, path);
-		}
+String JSON::getString(const JSONSpan& span) const {
+	String result;
+	if (span.isFound()) {
+		result.reserve(span.length);
+		StringSink sink(result);
+		decodeValue(_json + span.offset, span.length, sink);
 	}
 	return result;
 }
 
-String JSON::getElement(String jsonPath) const {
-	JSONTokenizer json(_jsonString);
-	JSONTokenizer path(jsonPath);
-	String result = unquote(getElementRec(json, path));
-	return result;
+bool JSON::getElement(const char* jsonPath, char* buffer, uint16_t bufferSize) const {
+	JSONSpan span;
+	BufferSink sink(buffer, bufferSize);
+	if (findElement(jsonPath, span)) {
+		decodeValue(_json + span.offset, span.length, sink);
+		return sink.terminate();
+	}
+	sink.terminate();
+	return false;
+}
+
+String JSON::getElement(const char* jsonPath) const {
+	JSONSpan span;
+	findElement(jsonPath, span);
+	return getString(span);
 }
 
-jsonObject_t JSON::parseObject(String jsonPath) const {
-    jsonObject_t result;
-    String subObject = getElement(jsonPath);
-    JSONTokenizer json(subObject);
-	json.skipExpectedToken("{");
-	String tk = json.getNextToken();
-	while (tk != "}") {
-		json.skipExpectedToken(":");
-		result[unquote(tk)] = unquote(getNextObject(json));
-		tk = json.getNextToken();
-		if (tk == ",") {
-		    tk = json.getNextToken();
-		} else if (tk != "}") {
-			json.setError("} or ,");
+Properties JSON::parseObject(const char* jsonPath) const {
+    Properties result;
+	JSONSpan span;
+	if (!findElement(jsonPath, span)) {
+		return result;
+	}
+	JSONTokenizer tokenizer(_json, span.offset + span.length, span.offset);
+	if (tokenizer.next().type != JSON_BEGIN_OBJECT) {
+		return result;
+	}
+	JSONToken token = tokenizer.next();
+	while (token.type == JSON_STRING) {
+		JSONSpan name;
+		name.offset = token.begin;
+		name.length = token.len;
+		if (tokenizer.next().type != JSON_COLON) {
+			break;
+		}
+		token = tokenizer.next();
+		if (!tokenizer.skipValue(token)) {
+			break;
+		}
+		JSONSpan value;
+		value.offset = token.begin;
+		value.length = tokenizer.getPos() - token.begin;
+		result.set(getString(name), getString(value));
+		if (tokenizer.next().type != JSON_COMMA) {
 			break;
 		}
+		token = tokenizer.next();
 	}
     return result;
-}
\ No newline at end of file
+}
@@ -6,91 +6,121 @@
  * @author Volker Böhm
  * @copyright Copyright (c) 2020 Volker Böhm
  * @brief
- * Provides a class to access a JSON formatted string by a JSON path
+ * Provides a non-owning view to read values from a JSON formatted string by a JSON path
  */
 
 #pragma once
-#include <map>
 #include <Arduino.h>
+#include <properties.h>
+#include "jsontokenizer.h"
 
 /**
- * Creates a json property string
- * @param name property name
- * @param value property string value
+ * Position and length of a value inside a JSON formatted string
  */
-String jsonStringProperty(String name, String value);
+struct JSONSpan {
+	JSONSpan() : offset(0), length(0) {}
+	uint16_t offset;
+	uint16_t length;
+
+	/**
+	 * @returns true, if the span points to a value
+	 */
+	bool isFound() const { return length > 0; }
+};
 
 /**
- * Creates a json object property string
- * @param name property name
- * @param object json definition of an object or array or non-string value as string
+ * Reads values from a JSON formatted string without copying it. The class only holds a pointer
+ * to the string, thus the string must live as long as the JSON object is used.
  */
-String jsonObjectProperty(String name, String object);
-
-class JSONTokenizer;
-
-typedef std::map<String, String> jsonObject_t;
-
 class JSON {
 public:
-	JSON(const String& jsonString) :_jsonString(jsonString) {}
-
 	/**
-	* Gets an element from the JSON fromatted string based on a json path
-	* @param jsonPath path of the for a.b[x] (as in javaScript)
-	*/
-	String getElement(String jsonPath) const;
-
-    /**
-     * Parses an object in JSON notation {...} and returns it as map
-     */
-    jsonObject_t parseObject(String jsonPath) const;
-
-private:
-	String _jsonString;
+	 * Creates a view on a String. The String is not copied, it must not be changed or destroyed
+	 * while the JSON object is used.
+	 * @param jsonString JSON formatted string
+	 */
+	JSON(const String& jsonString) : _json(jsonString.c_str()), _length(jsonString.length()) {}
 
 	/**
-	* Gets the content of an array
-	* @param json string tokenizer
-	* @returns Array content
-	*/
-	String getArrayContent(JSONTokenizer& json) const;
+	 * Rejects temporaries, the view would point to a destroyed String
+	 */
+	JSON(const String&& jsonString) = delete;
 
 	/**
-	* Gets the content of an object
-	* @param json string tokenizer
-	* @returns Object content
-	*/
-	String getObjectContent(JSONTokenizer& json) const;
+	 * Creates a view on a buffer. The buffer is not copied, it must stay valid and unchanged
+	 * while the JSON object is used.
+	 * @param json start of the JSON formatted data, needs not be zero terminated
+	 * @param length length of the data in bytes
+	 */
+	JSON(const char* json, uint16_t length) : _json(json), _length(length) {}
 
 	/**
-	* Gets the next object of a json
-	* @param json string tokenizer
-	*/
-	String getNextObject(JSONTokenizer& json) const;
+	 * Searches an element based on a json path in a single pass. Skipped values are not copied.
+	 * @param jsonPath path of the for a.b[x] (as in javaScript)
+	 * @param span receives offset and length of the raw value (strings including quotes)
+	 * @returns true, if found
+	 */
+	bool findElement(const char* jsonPath, JSONSpan& span) const;
 
+	/**
+	 * Searches several elements in one pass over the string. The scan stops as soon as all
+	 * paths are resolved, sub-trees not matching any open path are skipped.
+	 * @param jsonPaths list of paths of the for a.b[x] (as in javaScript)
+	 * @param spans receives offset and length of the raw values, one per path
+	 * @param count amount of paths, at most MAX_PATHS
+	 * @returns amount of elements found
+	 */
+	uint8_t getElements(const char* const* jsonPaths, JSONSpan* spans, uint8_t count) const;
+
+	template<uint8_t count>
+	uint8_t getElements(const char* const (&jsonPaths)[count], JSONSpan (&spans)[count]) const {
+		return getElements(jsonPaths, spans, count);
+	}
 
 	/**
-	* Searches the start position of a property of a json object
-	* @param json string tokenizer
-	* @param property property name
-	* @returns true, if found
-	*/
-	bool searchPropertyInObject(JSONTokenizer& json, const String& property) const;
+	 * Gets an element and decodes it to a buffer provided by the caller. Strings are unquoted
+	 * and unescaped, all other values are copied as they are. The result is always terminated.
+	 * @param jsonPath path of the for a.b[x] (as in javaScript)
+	 * @param buffer buffer receiving the element
+	 * @param bufferSize size of the buffer including the terminating zero
+	 * @returns true, if the element is found and fits into the buffer
+	 */
+	bool getElement(const char* jsonPath, char* buffer, uint16_t bufferSize) const;
 
 	/**
-	* Searches the start position of an array element
-	* @param json string tokenizer
-	* @param index index of the array element
-	* @returns true, if found
+	* Gets an element from the JSON fromatted string based on a json path
+	* @param jsonPath path of the for a.b[x] (as in javaScript)
+	* @returns decoded element or an empty string, if not found
 	*/
-	bool searchArrayElement(JSONTokenizer& json, uint16_t index) const;
+	String getElement(const char* jsonPath) const;
 
 	/**
-	* Recursively extracts a substring from a json string by following the path
-	* @param json string in JSON format
-	* @param path string in json path format
-	*/
-	String getElementRec(JSONTokenizer& json, JSONTokenizer& path) const;
+	 * Decodes a value found by findElement to a string
+	 * @param span position of the value
+	 */
+	String getString(const JSONSpan& span) const;
 
+    /**
+     * Parses an object in JSON notation {...} and returns its properties
+     */
+    Properties parseObject(const char* jsonPath) const;
+
+	static const uint8_t MAX_PATHS = 32;
+
+private:
+
+	/**
+	 * Recursively resolves all open paths inside a value
+	 * @param tokenizer tokenizer positioned behind the first token of the value
+	 * @param token first token of the value
+	 * @param paths current position in each path, advanced while descending
+	 * @param open bit mask of the paths to resolve inside this value
+	 * @param spans receives the spans of resolved paths
+	 * @param remaining amount of paths not yet resolved in the whole document
+	 */
+	void resolvePaths(JSONTokenizer& tokenizer, const JSONToken& token, const char** paths, 
+		uint32_t open, JSONSpan* spans, uint8_t& remaining) const;
+
+	const char* _json;
+	uint16_t _length;
 };
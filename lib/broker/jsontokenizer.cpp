@@ -11,85 +11,176 @@
 
 void JSONTokenizer::skipSpaces()
 {
-	while ((_data.charAt(_pos) == ' ') || (_data.charAt(_pos) == '\n'))
+	while (_pos < _length) {
+		const char curCh = _data[_pos];
+		if (curCh != ' ' && curCh != '\n' && curCh != '\r' && curCh != '\t')
+			break;
+		_pos++;
+	}
+}
+
+uint16_t JSONTokenizer::skipDigits()
+{
+	uint16_t start = _pos;
+	while (_pos < _length && (_data[_pos] >= '0') && (_data[_pos] <= '9'))
 		_pos++;
+	return _pos - start;
 }
 
-void JSONTokenizer::findChar(char searchCh, bool multiLine)
+bool JSONTokenizer::scanString()
 {
-	while ((_data.charAt(_pos) != searchCh) && (_data.charAt(_pos) != 0))
+	for (_pos++; _pos < _length; _pos++)
 	{
-		if (!multiLine && (_data.charAt(_pos) == '\n'))
-			break;
+		const char curCh = _data[_pos];
+		if (curCh == '"') {
+			_pos++;
+			return true;
+		}
+		if (curCh != '\\')
+			continue;
 		_pos++;
+		if (_pos >= _length)
+			return false;
+		switch (_data[_pos])
+		{
+		case '"':
+		case '\\':
+		case '/':
+		case 'b':
+		case 'f':
+		case 'n':
+		case 'r':
+		case 't':
+			break;
+		case 'u':
+			for (uint8_t i = 0; i < 4; i++) {
+				_pos++;
+				if (_pos >= _length || !isxdigit(_data[_pos]))
+					return false;
+			}
+			break;
+		default:
+			return false;
+		}
 	}
+	return false;
 }
 
-void JSONTokenizer::skipDigits()
+bool JSONTokenizer::scanNumber()
 {
-	while ((_data.charAt(_pos) >= '0') && (_data.charAt(_pos) <= '9'))
+	if (_data[_pos] == '-')
+		_pos++;
+	if (_pos < _length && _data[_pos] == '0') 
+		_pos++;
+	else if (skipDigits() == 0)
+		return false;
+	if (_pos < _length && _data[_pos] == '.') {
+		_pos++;
+		if (skipDigits() == 0)
+			return false;
+	}
+	if (_pos < _length && (_data[_pos] == 'e' || _data[_pos] == 'E')) {
 		_pos++;
+		if (_pos < _length && (_data[_pos] == '+' || _data[_pos] == '-'))
+			_pos++;
+		if (skipDigits() == 0)
+			return false;
+	}
+	return true;
 }
 
-void JSONTokenizer::skipSymbolContinuation()
+bool JSONTokenizer::scanLiteral(const char* literal)
 {
-	for (;; _pos++)
-	{
-		const char curCh = _data.charAt(_pos);
-		if (!(((curCh >= 'a') && (curCh <= 'z')) ||
-			((curCh >= '0') && (curCh <= '9')) ||
-			((curCh >= 'A') && (curCh <= 'Z')) ||
-			(curCh == '_') || (curCh == '+') ||
-			(curCh == '#') || (curCh == '=') ||
-			(curCh == ':') || (curCh == '-') || (curCh == '/')))
-			break;
-	}
+	uint16_t literalLength = strlen(literal);
+	if (_pos + literalLength > _length || strncmp(_data + _pos, literal, literalLength) != 0)
+		return false;
+	_pos += literalLength;
+	return true;
 }
 
-String JSONTokenizer::getNextToken()
+JSONToken JSONTokenizer::error(uint16_t begin)
 {
-	if (_error != "") {
-		return "";
+	if (_errorPos == NO_ERROR)
+		_errorPos = begin;
+	_pos = _length;
+	JSONToken token = { JSON_ERROR, begin, 0 };
+	return token;
+}
+
+JSONToken JSONTokenizer::next()
+{
+	if (hasError()) {
+		return error(_errorPos);
 	}
 	skipSpaces();
-	uint16_t tokenStartPos = _pos;
-	char curCh = _data.charAt(_pos);
+	JSONToken token = { JSON_END, _pos, 0 };
+	if (_pos >= _length) {
+		return token;
+	}
 
-	switch (curCh)
+	switch (_data[_pos])
 	{
 	case 0:
+		return token;
+	case '{': token.type = JSON_BEGIN_OBJECT; _pos++; break;
+	case '}': token.type = JSON_END_OBJECT; _pos++; break;
+	case '[': token.type = JSON_BEGIN_ARRAY; _pos++; break;
+	case ']': token.type = JSON_END_ARRAY; _pos++; break;
+	case ':': token.type = JSON_COLON; _pos++; break;
+	case ',': token.type = JSON_COMMA; _pos++; break;
+	case '"':
+		token.type = JSON_STRING;
+		if (!scanString())
+			return error(token.begin);
 		break;
-	case '[':
-	case ']':
-	case '{':
-	case '}':
-	case '(':
-	case ')':
-	case '<':
-	case '>':
-	case '.':
-	case '*':
-	case '!':
-	case '?':
-		// Special single char tokens
-		_pos++;
+	case 't':
+		token.type = JSON_TRUE;
+		if (!scanLiteral("true"))
+			return error(token.begin);
 		break;
-	case '"':
-		// Scan a string
-		_pos++;
-		findChar('"', false);
-		_pos++;
+	case 'f':
+		token.type = JSON_FALSE;
+		if (!scanLiteral("false"))
+			return error(token.begin);
+		break;
+	case 'n':
+		token.type = JSON_NULL;
+		if (!scanLiteral("null"))
+			return error(token.begin);
 		break;
 	default:
-		if (((curCh >= 'a') && (curCh <= 'z')) ||
-			((curCh >= '0') && (curCh <= '9')) ||
-			((curCh >= 'A') && (curCh <= 'Z')))
+		token.type = JSON_NUMBER;
+		if (!scanNumber())
+			return error(token.begin);
+	}
+	token.len = _pos - token.begin;
+	return token;
+}
+
+bool JSONTokenizer::skipValue(const JSONToken& first)
+{
+	if (first.type != JSON_BEGIN_OBJECT && first.type != JSON_BEGIN_ARRAY) {
+		return first.type >= JSON_STRING;
+	}
+	uint8_t depth = 1;
+	while (depth > 0) {
+		JSONToken token = next();
+		switch (token.type) 
 		{
-			skipSymbolContinuation();
+		case JSON_BEGIN_OBJECT:
+		case JSON_BEGIN_ARRAY:
+			depth++;
+			break;
+		case JSON_END_OBJECT:
+		case JSON_END_ARRAY:
+			depth--;
+			break;
+		case JSON_END:
+		case JSON_ERROR:
+			return false;
+		default:
+			break;
 		}
-		else
-			_pos++; // Unknown char
 	}
-	return _data.substring(tokenStartPos, _pos);
+	return true;
 }
-
@@ -13,67 +13,119 @@
 
 #include <Arduino.h>
 
-// This class implements a tokenizer used to tokenize JSON strings
+/**
+ * Types of JSON tokens
+ */
+enum JSONTokenType {
+	JSON_END,
+	JSON_ERROR,
+	JSON_BEGIN_OBJECT,
+	JSON_END_OBJECT,
+	JSON_BEGIN_ARRAY,
+	JSON_END_ARRAY,
+	JSON_COLON,
+	JSON_COMMA,
+	JSON_STRING,
+	JSON_NUMBER,
+	JSON_TRUE,
+	JSON_FALSE,
+	JSON_NULL
+};
+
+/**
+ * A token is a typed position in the tokenized buffer. Strings include the quotes.
+ */
+struct JSONToken {
+	JSONTokenType type;
+	uint16_t begin;
+	uint16_t len;
+
+	/**
+	 * @returns position behind the token
+	 */
+	uint16_t end() const { return begin + len; }
+};
+
+// This class implements a pull tokenizer for JSON strings. It does not copy the data.
 class JSONTokenizer
 {
 public:
-	// CTor
-	JSONTokenizer(const String &data) : _data(data), _pos(0), _error("") {}
-	// DTor
-	~JSONTokenizer(void)
-	{
-	}
+	/**
+	 * @param data buffer to tokenize, must live as long as the tokenizer is used
+	 * @param length length of the buffer
+	 * @param pos start position
+	 */
+	JSONTokenizer(const char* data, uint16_t length, uint16_t pos = 0) 
+		: _data(data), _length(length), _pos(pos), _errorPos(NO_ERROR) {}
 
 	/**
 	* Gets the next token
 	*/
-	String getNextToken();
+	JSONToken next();
 
 	/**
-	* Skips an expected token or throws an error
-	* @param expectedToken token that is expected
-	*/
-	String skipExpectedToken(const String& expectedToken) {
-		String result = getNextToken();
-		if (result != expectedToken) {
-			setError(expectedToken);
-		}
-		return result;
-	}
+	 * Skips the rest of a value, the first token of the value has already been read
+	 * @param first first token of the value
+	 * @returns true, if the value is complete
+	 */
+	bool skipValue(const JSONToken& first);
 
 	/**
-	 * Sets an error condition
-	 * @param text expected value/situation
+	 * @returns position behind the last token read
 	 */
-	void setError(const String& text) {
-		_error = String("Error at pos ") + String(_pos) + String(" expected: ") + text;
-	}
+	uint16_t getPos() const { return _pos; }
+
+	/**
+	 * @returns true, if the tokenizer encountered a syntax error
+	 */
+	bool hasError() const { return _errorPos != NO_ERROR; }
+
+	/**
+	 * @returns position of the first syntax error
+	 */
+	uint16_t getErrorPos() const { return _errorPos; }
 
 private:
+	static const uint16_t NO_ERROR = 0xFFFF;
+
 	/**
-	* Skips all spaces and line breaks
+	* Skips all spaces, tabs and line breaks
 	*/
 	void skipSpaces();
 
 	/**
-	* Search a string until a special char is found or until line end (if multiLine is false)
-	* @param searchCh char to search for
-	* @param multiLine true, if the search should pass line ends
-	*/
-	void findChar(char searchCh, bool multiLine);
+	 * Scans a string including escape sequences, _pos is at the opening quote
+	 * @returns true, if the string is valid and terminated
+	 */
+	bool scanString();
+
+	/**
+	 * Scans a number -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+	 * @returns true, if the number is valid
+	 */
+	bool scanNumber();
+
+	/**
+	 * Scans a literal
+	 * @param literal expected literal (true, false or null)
+	 * @returns true, if the literal matches
+	 */
+	bool scanLiteral(const char* literal);
 
 	/**
 	* Skips all Digits
+	* @returns amount of digits skipped
 	*/
-	void skipDigits();
+	uint16_t skipDigits();
 
 	/**
-	* Skips all characters allowed in symbols
-	*/
-	void skipSymbolContinuation();
+	 * Creates an error token and remembers the error position
+	 * @param begin start of the erroneous token
+	 */
+	JSONToken error(uint16_t begin);
 
-	String _data;
+	const char* _data;
+	uint16_t _length;
 	uint16_t _pos;
-	String _error;
+	uint16_t _errorPos;
 };
-
@@ -0,0 +1,133 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ */
+
+#include "jsonwriter.h"
+
+void JSONWriter::write(const char* str, size_t length) {
+    if (_buffer != 0) {
+        _buffer->concat(str, length);
+    } else if (_out != 0) {
+        _out->write((const uint8_t*) str, length);
+    }
+    _length += length;
+}
+
+void JSONWriter::writeString(const char* str) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    write('"');
+    const char* start = str;
+    for (; *str != 0; str++) {
+        const char ch = *str;
+        if (ch != '"' && ch != '\\' && (uint8_t) ch >= 0x20) {
+            continue;
+        }
+        write(start, str - start);
+        start = str + 1;
+        char escaped[7] = { '\\', ch, 0, 0, 0, 0, 0 };
+        uint8_t escapedLength = 2;
+        switch (ch) {
+            case '"': case '\\': break;
+            case '\n': escaped[1] = 'n'; break;
+            case '\r': escaped[1] = 'r'; break;
+            case '\t': escaped[1] = 't'; break;
+            case '\b': escaped[1] = 'b'; break;
+            case '\f': escaped[1] = 'f'; break;
+            default:
+                escaped[1] = 'u';
+                escaped[2] = '0';
+                escaped[3] = '0';
+                escaped[4] = HEX_DIGITS[(ch >> 4) & 0x0F];
+                escaped[5] = HEX_DIGITS[ch & 0x0F];
+                escapedLength = 6;
+        }
+        write(escaped, escapedLength);
+    }
+    write(start, str - start);
+    write('"');
+}
+
+void JSONWriter::beginMember(const char* name) {
+    const uint32_t bit = _depth < MAX_DEPTH ? uint32_t(1) << _depth : 0;
+    if (_hasMember & bit) {
+        write(',');
+    }
+    _hasMember |= bit;
+    if (name != 0) {
+        writeString(name);
+        write(':');
+    }
+}
+
+void JSONWriter::beginContainer(const char* name, char open) {
+    if (_depth > 0) {
+        beginMember(name);
+    }
+    write(open);
+    _depth++;
+    if (_depth < MAX_DEPTH) {
+        _hasMember &= ~(uint32_t(1) << _depth);
+    }
+}
+
+void JSONWriter::endContainer(char close) {
+    write(close);
+    if (_depth > 0) {
+        _depth--;
+    }
+}
+
+JSONWriter& JSONWriter::beginObject(const char* name) {
+    beginContainer(name, '{');
+    return *this;
+}
+
+JSONWriter& JSONWriter::endObject() {
+    endContainer('}');
+    return *this;
+}
+
+JSONWriter& JSONWriter::beginArray(const char* name) {
+    beginContainer(name, '[');
+    return *this;
+}
+
+JSONWriter& JSONWriter::endArray() {
+    endContainer(']');
+    return *this;
+}
+
+JSONWriter& JSONWriter::property(const char* name, const char* value) {
+    beginMember(name);
+    writeString(value);
+    return *this;
+}
+
+JSONWriter& JSONWriter::numberProperty(const char* name, long value) {
+    char number[12];
+    snprintf(number, sizeof(number), "%ld", value);
+    return rawProperty(name, number);
+}
+
+JSONWriter& JSONWriter::rawProperty(const char* name, const char* json) {
+    beginMember(name);
+    write(json, strlen(json));
+    return *this;
+}
+
+JSONWriter& JSONWriter::value(const char* value) {
+    beginMember(0);
+    writeString(value);
+    return *this;
+}
+
+JSONWriter& JSONWriter::rawValue(const char* json) {
+    beginMember(0);
+    write(json, strlen(json));
+    return *this;
+}
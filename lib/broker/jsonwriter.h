@@ -0,0 +1,152 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Provides a class to write JSON formatted data in one pass
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Writes JSON either to a string, to a Print (for example a WiFiClient) or nowhere, just counting
+ * the characters. Commas between members are set automatically, string values are escaped.
+ */
+class JSONWriter {
+public:
+    /**
+     * Writer counting the length of the output only
+     */
+    JSONWriter() : _buffer(0), _out(0), _length(0), _depth(0), _hasMember(0) {}
+
+    /**
+     * Writer appending to a string
+     * @param buffer string to append to, reserve memory to prevent reallocation
+     */
+    JSONWriter(String& buffer) : _buffer(&buffer), _out(0), _length(0), _depth(0), _hasMember(0) {}
+
+    /**
+     * Writer streaming the output
+     * @param out stream to write to
+     */
+    JSONWriter(Print& out) : _buffer(0), _out(&out), _length(0), _depth(0), _hasMember(0) {}
+
+    /**
+     * Starts an object
+     * @param name property name, if the object is a property of an object
+     */
+    JSONWriter& beginObject(const char* name = 0);
+
+    /**
+     * Ends the current object
+     */
+    JSONWriter& endObject();
+
+    /**
+     * Starts an array
+     * @param name property name, if the array is a property of an object
+     */
+    JSONWriter& beginArray(const char* name = 0);
+
+    /**
+     * Ends the current array
+     */
+    JSONWriter& endArray();
+
+    /**
+     * Writes a string property, the value is escaped
+     * @param name property name
+     * @param value property value
+     */
+    JSONWriter& property(const char* name, const char* value);
+    JSONWriter& property(const char* name, const String& value) { return property(name, value.c_str()); }
+
+    /**
+     * Writes a number property
+     * @param name property name
+     * @param value property value
+     */
+    JSONWriter& numberProperty(const char* name, long value);
+
+    /**
+     * Writes a property with a value already formatted as JSON (number, literal, object)
+     * @param name property name
+     * @param json property value in JSON format
+     */
+    JSONWriter& rawProperty(const char* name, const char* json);
+
+    /**
+     * Writes a string as array element, the value is escaped
+     * @param value array element
+     */
+    JSONWriter& value(const char* value);
+    JSONWriter& value(const String& value) { return this->value(value.c_str()); }
+
+    /**
+     * Writes an array element already formatted as JSON
+     * @param json array element in JSON format
+     */
+    JSONWriter& rawValue(const char* json);
+
+    /**
+     * @returns amount of characters written
+     */
+    size_t getLength() const { return _length; }
+
+private:
+    static const uint8_t MAX_DEPTH = 32;
+
+    /**
+     * Writes a comma, if the current object or array already has members, and the property name
+     * @param name property name or 0 for array elements
+     */
+    void beginMember(const char* name);
+
+    /**
+     * Starts an object or an array
+     * @param name property name or 0
+     * @param open opening bracket
+     */
+    void beginContainer(const char* name, char open);
+
+    /**
+     * Ends an object or an array
+     * @param close closing bracket
+     */
+    void endContainer(char close);
+
+    /**
+     * Writes a string in quotes, escapes special characters
+     */
+    void writeString(const char* str);
+
+    void write(const char* str, size_t length);
+    void write(char ch) { write(&ch, 1); }
+
+    String* _buffer;
+    Print* _out;
+    size_t _length;
+    uint8_t _depth;
+    uint32_t _hasMember;
+};
+
+/**
+ * Creates a JSON string with exactly one allocation. The write function is called twice, first
+ * to measure the length and then to write into the reserved string
+ * @param write function writing the JSON, signature void(JSONWriter&)
+ */
+template<class TWriteFunction>
+String jsonToString(TWriteFunction write) {
+    JSONWriter counter;
+    write(counter);
+    String result;
+    result.reserve(counter.getLength());
+    JSONWriter writer(result);
+    write(writer);
+    return result;
+}
@@ -14,6 +14,7 @@
 #include <Arduino.h>
 #include <vector>
 #include <json.h>
+#include <jsonwriter.h>
 
 class Message {
 public:
@@ -23,20 +24,31 @@ public:
         _message = message;
     }
 
+    const String& getTopic() const { return _topic; }
+    const String& getValue() const { return _value; }
+
     /**
      * Creates the string to publish the message
      * @returns message in yaha mqtt format
      */
     String toPublishString() const {
-        const String reasonArray = "[{" +
-            jsonStringProperty("message", _message) + 
-        "}]";
-        const String result = "{" +
-            jsonStringProperty("topic", _topic) + "," +
-            jsonStringProperty("value", _value) + "," +
-            jsonObjectProperty("reason", reasonArray) +
-        "}";
-        return result;
+        return jsonToString([this](JSONWriter& json) { writeTo(json); });
+    }
+
+    /**
+     * Writes the message in yaha mqtt format
+     * @param json writer to write the message object to
+     */
+    void writeTo(JSONWriter& json) const {
+        json.beginObject()
+            .property("topic", _topic)
+            .property("value", _value)
+            .beginArray("reason")
+                .beginObject()
+                    .property("message", _message)
+                .endObject()
+            .endArray()
+        .endObject();
     }
 
     
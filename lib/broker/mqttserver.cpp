@@ -12,24 +12,32 @@
 #define __DEBUG
 #include "debug.h"
 #include "mqttserver.h"
-#include "htmlpages.h"
 #include "json.h"
+#include "chunkedwriter.h"
+#include "jsonwriter.h"
+#include <heapmonitor.h>
 
 ESP8266WebServer* MQTTServer::_httpServer = 0;
 TOnUpdateFunction MQTTServer::_onUpdateFunction = 0;
-std::map<String, String> MQTTServer::_data;
-std::map<String, String> MQTTServer::_forms;
+Properties MQTTServer::_data;
+Properties MQTTServer::_state;
+uint32_t MQTTServer::_stateTime;
+std::map<String, FormTemplate> MQTTServer::_forms;
 std::map<String, String> MQTTServer::_formNames;
 bool MQTTServer::_isChanged;
+uint32_t MQTTServer::_bootId;
     
 void MQTTServer::onPublish() {
     String postBody = _httpServer->arg("plain");
     PRINTLN_IF_DEBUG("Received PUT publish command body:");
     PRINTLN_IF_DEBUG(postBody);
     JSON json(postBody);
-    String topic = json.getElement("message.topic");
+    const char* paths[] = { "message.topic", "message.value" };
+    JSONSpan spans[2];
+    json.getElements(paths, spans);
+    String topic = json.getString(spans[0]);
     PRINTLN_VARIABLE_IF_DEBUG(topic)
-    String value = json.getElement("message.value");
+    String value = json.getString(spans[1]);
     PRINTLN_VARIABLE_IF_DEBUG(value)
     topic.replace("/set", "");
     uint16_t lastChunkStart = topic.lastIndexOf("/");
@@ -52,40 +60,134 @@ void MQTTServer::onPublish() {
     delay(10);
 }
 
+bool MQTTServer::isSecret(const char* key) {
+    String lowerCaseKey = key;
+    lowerCaseKey.toLowerCase();
+    return lowerCaseKey.endsWith("password");
+}
 
-String MQTTServer::replaceFormValues(const String& form) {
-    String result = form;
-    for (auto const& x: _data) {
-        String valueString = "[value]=\"" + x.first + "\"";
-        String checkedString = "[checked]=\"" + x.first + "\"";
-        result.replace(valueString, "value=\"" + x.second + "\"");
-        result.replace(checkedString, x.second == "on" ? "checked=\"checked\"" : "");
+void MQTTServer::sendProperties(const Properties& properties, JSONWriter& json) {
+    for (uint16_t i = 0; i < properties.size(); i++) {
+        if (!isSecret(properties.getKey(i))) {
+            json.property(properties.getKey(i), properties.getValue(i).c_str());
+        }
     }
-    return result;
 }
 
-String MQTTServer::createTopNav(const String& activeLink) {
-    String topNav = "<div class=\"topnav\">";
+void MQTTServer::onGetConfig() {
+    _httpServer->sendHeader("Cache-Control", "no-store");
+    ChunkedWriter out(*_httpServer, 200, "application/json");
+    JSONWriter json(out);
+    json.beginObject();
+    sendProperties(_data, json);
+    json.endObject();
+    out.end();
+}
+
+void MQTTServer::onPatchConfig() {
+    String body = _httpServer->arg("plain");
+    PRINTLN_IF_DEBUG("Received PATCH config body:");
+    PRINTLN_IF_DEBUG(body);
+    Properties changes = JSON(body).parseObject("");
+    if (changes.size() == 0) {
+        _httpServer->send(400, "text/plain", "Expected a JSON object with configuration values\n");
+        return;
+    }
+    for (uint16_t i = 0; i < changes.size(); i++) {
+        if (!_data.has(changes.getKey(i))) {
+            _httpServer->send(400, "text/plain", String("Unknown configuration key: ") + changes.getKey(i) + "\n");
+            return;
+        }
+    }
+    _data.set(changes);
+    // Called once for all changes, thus the eeprom is written once per request
+    _onUpdateFunction(_data);
+    setChanged(true);
+    onGetConfig();
+}
+
+void MQTTServer::onGetState() {
+    _httpServer->sendHeader("Cache-Control", "no-store");
+    ChunkedWriter out(*_httpServer, 200, "application/json");
+    JSONWriter json(out);
+    json.beginObject()
+        .numberProperty("ageInSeconds", (millis() - _stateTime) / 1000)
+        .beginObject("values");
+    sendProperties(_state, json);
+    json.endObject().endObject();
+    out.end();
+}
+
+void MQTTServer::setState(const String& baseTopic, const Messages_t& messages) {
+    for (auto const& message: messages) {
+        const String& topic = message.getTopic();
+        if (topic.startsWith(baseTopic)) {
+            _state.set(topic.substring(baseTopic.length() + 1), message.getValue());
+        }
+    }
+    _stateTime = millis();
+}
+
+void MQTTServer::writeTopNav(const String& activeLink, Print& out) {
+    out.print("<div class=\"topnav\">");
     for (auto const& form: _formNames) {
-        topNav += "<a";
+        out.print("<a");
         if (form.first == activeLink) {
-            topNav += " class=\"active\"";
+            out.print(" class=\"active\"");
         }
-        topNav += " href=\"";
-        topNav += form.first;
-        topNav += "\">";
-        topNav += form.second;
-        topNav += "</a>";
+        out.print(" href=\"");
+        out.print(form.first);
+        out.print("\">");
+        out.print(form.second);
+        out.print("</a>");
     }
-    topNav += "</div>";
-    return topNav;
+    out.print("</div>");
+}
+
+String MQTTServer::createPageETag(const String& uri) {
+    auto form = _forms.find(uri);
+    String etag = "\"";
+    etag += String(form == _forms.end() ? 0 : form->second.getHash(), HEX);
+    etag += '-';
+    etag += String(_bootId, HEX);
+    etag += '-';
+    etag += String(_data.getRevision());
+    etag += '"';
+    return etag;
 }
 
-String MQTTServer::createForm(const String& uri) {
-    String form = _forms[uri];
-    String bodyForm = "<div class=\"container\">" + replaceFormValues(form) + "</div></body></html>";
-    String topNav = createTopNav(uri);
-    return htmlPage + topNav + bodyForm;
+bool MQTTServer::isNotModified(const String& etag) {
+    _httpServer->sendHeader("ETag", etag);
+    if (_httpServer->header("If-None-Match") != etag) {
+        return false;
+    }
+    _httpServer->send(304);
+    return true;
+}
+
+void MQTTServer::sendStaticAsset(const StaticAsset& asset) {
+    _httpServer->sendHeader("Cache-Control", "max-age=3600");
+    if (isNotModified(asset.etag)) {
+        return;
+    }
+    if (asset.isGzip) {
+        _httpServer->sendHeader("Content-Encoding", "gzip");
+    }
+    _httpServer->send_P(200, asset.contentType, asset.data, asset.length);
+}
+
+void MQTTServer::sendForm(const String& uri) {
+    HeapMonitor::Scope heapScope(HeapMonitor::FORM);
+    ChunkedWriter out(*_httpServer, 200, "text/html");
+    out.writeP(headHtml);
+    writeTopNav(uri, out);
+    out.print("<div class=\"container\">");
+    auto form = _forms.find(uri);
+    if (form != _forms.end()) {
+        form->second.render(_data, out);
+    }
+    out.print("</div></body></html>");
+    out.end();
 }
 
 void MQTTServer::on(const String& uri) {
@@ -99,24 +201,25 @@ void MQTTServer::on(const String& uri) {
             PRINTLN_VARIABLE_IF_DEBUG(_httpServer->arg(i))
             bool isPlainArgumentList = _httpServer->argName(i) == "plain";
             if (!isPlainArgumentList) {
-                _data[_httpServer->argName(i)] = _httpServer->arg(i);
+                _data.set(_httpServer->argName(i), _httpServer->arg(i));
             }
         }
         handler();
-        String form = createForm(uri);
-        _httpServer->send(200, "text/html", form);
+        sendForm(uri);
     });
 }
 
 
 
-void MQTTServer::addForm(const String& uri, const String& name, const String& form) {
+void MQTTServer::addForm(const String& uri, const String& name, PGM_P form) {
     _formNames[uri] = name;
-    _forms[uri] = form;
+    _forms[uri] = FormTemplate(form);
     on(uri);
     _httpServer->on(uri, HTTP_GET, [uri]() {
-        String filledForm = createForm(uri);
-        _httpServer->send(200, "text/html", filledForm);
+        _httpServer->sendHeader("Cache-Control", "no-cache");
+        if (!isNotModified(createPageETag(uri))) {
+            sendForm(uri);
+        }
     });
 
 }
@@ -131,10 +234,13 @@ void MQTTServer::registerOnUpdateFunction(TOnUpdateFunction handler) {
 
 void MQTTServer::restServerRouting() {
     _httpServer->on("/publish", HTTP_PUT, onPublish);
-    _httpServer->on("/css.css", HTTP_GET, []() {
-        _httpServer->sendHeader("Cache-Control", "max-age=3600");
-        _httpServer->send(200, "text/css", cssFile);
-    });
+    _httpServer->on("/api/config", HTTP_GET, onGetConfig);
+    _httpServer->on("/api/config", HTTP_PATCH, onPatchConfig);
+    _httpServer->on("/api/state", HTTP_GET, onGetState);
+    for (uint8_t index = 0; index < staticAssetCount; index++) {
+        const StaticAsset* asset = &staticAssets[index];
+        _httpServer->on(asset->path, HTTP_GET, [asset]() { sendStaticAsset(*asset); });
+    }
     _httpServer->onNotFound([]() {
         String message = "Resource not found\n URI: " + _httpServer->uri() + "\n";
         PRINTLN_VARIABLE_IF_DEBUG(message)
@@ -144,10 +250,11 @@ void MQTTServer::restServerRouting() {
 
 void MQTTServer::begin(uint32_t port) {
     _httpServer = new ESP8266WebServer(port);
+    _bootId = ESP.random();
     restServerRouting();
     // headers are not automatically collected
     // All headers needed must be listed here in the header list to be "collected"
-    const char* headers[] = {"packetid", "dup", "version"};
+    const char* headers[] = {"packetid", "dup", "version", "If-None-Match"};
     _httpServer->collectHeaders(headers, sizeof(headers)/ sizeof(headers[0]));
     _httpServer->begin();
 }
@@ -155,13 +262,11 @@ void MQTTServer::begin(uint32_t port) {
 
 Messages_t MQTTServer::getMessages(const String& baseTopic) {
     Messages_t result;
-    for (auto const& property: _data) {
-        String lowerCasePropertyName = property.first;
-        lowerCasePropertyName.toLowerCase();
-        if (lowerCasePropertyName.endsWith("password")) {
+    for (uint16_t i = 0; i < _data.size(); i++) {
+        if (isSecret(_data.getKey(i))) {
             continue;
         }
-        const Message propertyMessage(baseTopic + "/" + property.first, property.second, "info from ESP8266");
+        const Message propertyMessage(baseTopic + "/" + _data.getKey(i), String(_data.getValue(i)), "info from ESP8266");
         result.push_back(propertyMessage);
     }
     return result;
@@ -15,8 +15,12 @@
 #include <map>
 #include <message.h>
 #include <htmlpageinfo.h>
+#include <properties.h>
+#include <assets.h>
+#include "formtemplate.h"
+#include "jsonwriter.h"
 
-typedef std::function<void(std::map<String, String>&)> TOnUpdateFunction;
+typedef std::function<void(const Properties&)> TOnUpdateFunction;
 typedef std::function<void()> THandlerFunction;
 
 class MQTTServer {
@@ -40,14 +44,17 @@ public:
     /**
      * Sets data for forms
      */
-    static void setData(const String& key, const String& value) { _data[key] = value; }
-    static void setData(jsonObject_t configuration) { 
-        for (auto const& x: configuration) {
-            _data[x.first] = x.second;
-        }
-    }
+    static void setData(const String& key, const String& value) { _data.set(key, value); }
+    static void setData(const Properties& configuration) { _data.set(configuration); }
 
-    static jsonObject_t& getData() { return _data; }
+    static const Properties& getData() { return _data; }
+
+    /**
+     * Stores the latest measured values provided by GET /api/state
+     * @param baseTopic start string of the topics, removed from the keys
+     * @param messages messages with measured values
+     */
+    static void setState(const String& baseTopic, const Messages_t& messages);
 
     /**
      * Registers a function beeing called on http/https request
@@ -59,9 +66,9 @@ public:
      * Adds a form to the mqtt server
      * @param uri link to access the form
      * @param name Name of the form shown in the menu
-     * @param form html form including surrounding container - div
+     * @param form html form in PROGMEM
      */
-    static void addForm(const String& uri, const String& name, const String& form);
+    static void addForm(const String& uri, const String& name, PGM_P form);
     static void addForm(const HtmlPageInfo& pageInfo) { 
         if (pageInfo.hasForm) {
             addForm(pageInfo._uri, pageInfo._menuName, pageInfo._form); 
@@ -91,31 +98,79 @@ private:
      */
     static void onPublish();
 
+    /**
+     * Handles GET /api/config, sends all configuration values beside passwords as JSON object
+     */
+    static void onGetConfig();
+
+    /**
+     * Handles PATCH /api/config, changes the configuration values provided as JSON object. Unknown
+     * keys reject the whole request. Answers with the complete configuration.
+     */
+    static void onPatchConfig();
+
+    /**
+     * Handles GET /api/state, sends the latest measured values and their age as JSON object
+     */
+    static void onGetState();
+
+    /**
+     * Writes properties beside passwords as JSON properties
+     * @param properties properties to write
+     * @param json writer of the current JSON object
+     */
+    static void sendProperties(const Properties& properties, JSONWriter& json);
+
+    /**
+     * @returns true, if the value of the key must not leave the device
+     */
+    static bool isSecret(const char* key);
+
     /**
      * routes the rest messages to a matching function
      */
     static void restServerRouting();
 
     /**
-     * Replaces values in a form
+     * Sends a static file generated from web/static, browsers revalidate it after an hour
+     * @param asset file with precompressed content and a build time entity tag
+     */
+    static void sendStaticAsset(const StaticAsset& asset);
+
+    /**
+     * Streams a page with a filled form as chunked response
+     * @param uri link of the form
+     */
+    static void sendForm(const String& uri);
+
+    /**
+     * Creates the entity tag of a form page. It changes, if the form, the data or the firmware 
+     * (by restart) changes.
+     * @param uri link of the form
      */
-    static String replaceFormValues(const String& form); 
+    static String createPageETag(const String& uri);
 
     /**
-     * Creates a form
+     * Sends the entity tag and answers 304, if the client has a matching version cached
+     * @param etag entity tag of the current content
+     * @returns true, if 304 is sent and no content must be sent
      */
-    static String createForm(const String& uri);
+    static bool isNotModified(const String& etag);
 
     /**
-     * Creates the navigation menu
+     * Writes the navigation menu
      * @param activeLink relative link of the currently active page
+     * @param out output to write the menu to
      */
-    static String createTopNav(const String& activeLink);
+    static void writeTopNav(const String& activeLink, Print& out);
 
     static ESP8266WebServer* _httpServer;
     static TOnUpdateFunction _onUpdateFunction;
-    static std::map<String, String> _data;
+    static Properties _data;
+    static Properties _state;
+    static uint32_t _stateTime;
     static std::map<String, String> _formNames;
-    static std::map<String, String> _forms;
+    static std::map<String, FormTemplate> _forms;
     static bool _isChanged;
+    static uint32_t _bootId;
 };
@@ -0,0 +1,92 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ */
+
+#define __DEBUG
+#include "debug.h"
+#include "publishfilter.h"
+#include "hash.h"
+
+void PublishFilter::setDeadband(const String& topicEnd, float absolute, float relative) {
+    for (auto& deadband: _deadbands) {
+        if (deadband.topicEnd == topicEnd) {
+            deadband.absolute = absolute;
+            deadband.relative = relative;
+            return;
+        }
+    }
+    _deadbands.push_back(Deadband{ topicEnd, absolute, relative });
+}
+
+uint32_t PublishFilter::hash(const String& text) {
+    return hashBytes(text.c_str(), text.length());
+}
+
+uint8_t PublishFilter::find(uint32_t topicHash) const {
+    uint8_t result = 0;
+    while (result < _size && _delivered[result].topicHash != topicHash) {
+        result++;
+    }
+    return result;
+}
+
+const PublishFilter::Deadband* PublishFilter::getDeadband(const String& topic) const {
+    for (auto const& deadband: _deadbands) {
+        if (topic.endsWith(deadband.topicEnd)) {
+            return &deadband;
+        }
+    }
+    return nullptr;
+}
+
+bool PublishFilter::isChanged(const String& topic, const Delivered& delivered, const String& value) const {
+    const Deadband* deadband = getDeadband(topic);
+    if (deadband == nullptr) {
+        return hash(value) != delivered.valueHash;
+    }
+    float difference = fabs(value.toFloat() - delivered.value);
+    return difference > deadband->absolute && difference > deadband->relative * fabs(delivered.value);
+}
+
+bool PublishFilter::pass(const Message& message) const {
+    uint8_t index = find(hash(message.getTopic()));
+    if (index == _size) {
+        return true;
+    }
+    const Delivered& delivered = _delivered[index];
+    bool isSilent = _maxSilence > 0 && millis() - delivered.time >= _maxSilence;
+    return isSilent || isChanged(message.getTopic(), delivered, message.getValue());
+}
+
+Messages_t PublishFilter::filter(const Messages_t& messages) const {
+    Messages_t result;
+    for (auto const& message: messages) {
+        if (pass(message)) {
+            result.push_back(message);
+        }
+    }
+    return result;
+}
+
+void PublishFilter::delivered(const Message& message) {
+    uint32_t now = millis();
+    uint32_t topicHash = hash(message.getTopic());
+    uint8_t index = find(topicHash);
+    if (index == _size && _size < MAX_TOPICS) {
+        _size++;
+    } else if (index == _size) {
+        // Forgets the topic delivered longest ago, it is published again with its next message
+        index = 0;
+        for (uint8_t i = 1; i < _size; i++) {
+            if (now - _delivered[i].time > now - _delivered[index].time) {
+                index = i;
+            }
+        }
+    }
+    _delivered[index] = Delivered{ topicHash, hash(message.getValue()), message.getValue().toFloat(), now };
+}
@@ -0,0 +1,115 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Provides a filter passing only messages with changed values
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "message.h"
+
+/**
+ * Remembers the last delivered value per topic and passes a message only, if its value changed.
+ * Numeric values of topics with a deadband must change by more than the deadband. Every topic
+ * is published again after maxSilence seconds, even if its value did not change.
+ * Topics and string values are compared by hash, up to MAX_TOPICS topics are remembered; if more
+ * topics are delivered, the one delivered longest ago is forgotten.
+ * The cache is kept in RAM and starts empty after each deep sleep, thus the filter reduces the
+ * messages of mains powered devices only. The free RTC memory is too small to keep it.
+ */
+class PublishFilter {
+public:
+    static const uint32_t DEFAULT_MAX_SILENCE_IN_SECONDS = 15 * 60;
+    static const uint8_t MAX_TOPICS = 24;
+
+    PublishFilter() : _maxSilence(DEFAULT_MAX_SILENCE_IN_SECONDS * 1000), _size(0) {}
+
+    /**
+     * Sets a deadband for all topics ending with topicEnd. A value is published, if it differs
+     * from the last delivered value by more than the larger of absolute and relative * last value.
+     * @param topicEnd end of the topic, e.g. "sensor/temperature"
+     * @param absolute absolute deadband, e.g. 0.1 for 0.1 °C
+     * @param relative relative deadband, e.g. 0.01 for 1%
+     */
+    void setDeadband(const String& topicEnd, float absolute, float relative = 0);
+
+    /**
+     * Sets the time after which an unchanged value is published again
+     * @param seconds maximal time between two messages of a topic, 0 to publish changes only
+     */
+    void setMaxSilence(uint32_t seconds) { _maxSilence = seconds * 1000; }
+
+    /**
+     * Checks, if a message must be published. The value is remembered by delivered only, thus 
+     * a value is passed again until the broker accepted it.
+     * @param message message to check
+     * @returns true, if the message must be published
+     */
+    bool pass(const Message& message) const;
+
+    /**
+     * Filters a list of messages
+     * @param messages messages to check
+     * @returns messages that must be published
+     */
+    Messages_t filter(const Messages_t& messages) const;
+
+    /**
+     * Remembers the value of a message accepted by the broker
+     * @param message delivered message
+     */
+    void delivered(const Message& message);
+
+    /**
+     * Forgets all delivered values, the next messages are all published
+     */
+    void clear() { _size = 0; }
+
+private:
+    struct Deadband {
+        String topicEnd;
+        float absolute;
+        float relative;
+    };
+
+    struct Delivered {
+        uint32_t topicHash;
+        uint32_t valueHash;
+        float value;
+        uint32_t time;
+    };
+
+    /**
+     * @returns 32 bit hash of a string
+     */
+    static uint32_t hash(const String& text);
+
+    /**
+     * Searches the entry of a topic
+     * @param topicHash hash of the topic
+     * @returns index of the entry or _size, if the topic was not delivered yet
+     */
+    uint8_t find(uint32_t topicHash) const;
+
+    /**
+     * @returns the deadband of a topic or nullptr, if the topic has none
+     */
+    const Deadband* getDeadband(const String& topic) const;
+
+    /**
+     * Checks, if a new value is outside of the deadband
+     */
+    bool isChanged(const String& topic, const Delivered& delivered, const String& value) const;
+
+    std::vector<Deadband> _deadbands;
+    Delivered _delivered[MAX_TOPICS];
+    uint32_t _maxSilence;
+    uint8_t _size;
+};
@@ -0,0 +1,80 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ */
+
+#define __DEBUG
+#include "debug.h"
+#include "publishqueue.h"
+
+bool PublishQueue::dropOldest() {
+    if (_messages.size() <= _inFlight) {
+        return false;
+    }
+    _messages.erase(_messages.begin() + _inFlight);
+    _droppedAmount++;
+    return true;
+}
+
+void PublishQueue::setDepth(uint8_t depth) {
+    _depth = depth == 0 ? 1 : depth;
+    while (_messages.size() > _depth) {
+        if (!dropOldest()) {
+            break;
+        }
+    }
+}
+
+void PublishQueue::push(const Message& message, uint8_t qos, bool retain) {
+    if (_messages.size() >= _depth) {
+        PRINTLN_IF_DEBUG("Publish queue full, dropping oldest message")
+        if (!dropOldest()) {
+            // The messages in flight are still needed to handle the answer of the broker
+            _droppedAmount++;
+            return;
+        }
+    }
+    _messages.push_back(QueuedMessage(message, qos, retain));
+}
+
+uint8_t PublishQueue::getBatchSize(uint8_t maxAmount) const {
+    uint8_t amount = 0;
+    for (auto const& entry: _messages) {
+        if (amount >= maxAmount || entry.qos != _messages.front().qos || entry.retain != _messages.front().retain) {
+            break;
+        }
+        amount++;
+    }
+    return amount;
+}
+
+void PublishQueue::pop(uint8_t amount) {
+    answered(amount);
+    for (; amount > 0 && !_messages.empty(); amount--) {
+        if (_delivered) {
+            _delivered(_messages.front().message);
+        }
+        _messages.pop_front();
+    }
+}
+
+void PublishQueue::failed(uint8_t amount) {
+    answered(amount);
+    // Messages kept for a retry are moved behind the failed block to preserve their order
+    std::deque<QueuedMessage> retry;
+    for (; amount > 0 && !_messages.empty(); amount--) {
+        QueuedMessage& entry = _messages.front();
+        entry.attempts++;
+        if (entry.qos > 0 && entry.attempts < MAX_ATTEMPTS) {
+            retry.push_back(entry);
+        } else {
+            _droppedAmount++;
+        }
+        _messages.pop_front();
+    }
+    _messages.insert(_messages.begin(), retry.begin(), retry.end());
+}
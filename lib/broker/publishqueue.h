@@ -0,0 +1,130 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Provides a bounded queue of messages waiting to be published
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <deque>
+#include <functional>
+#include "message.h"
+
+/**
+ * A message waiting in the publish queue
+ */
+struct QueuedMessage {
+    QueuedMessage(const Message& message, uint8_t qos, bool retain) 
+        : message(message), qos(qos), retain(retain), attempts(0) {}
+    Message message;
+    uint8_t qos;
+    bool retain;
+    uint8_t attempts;
+};
+
+/**
+ * Bounded queue of outgoing messages. If the queue is full, the oldest message is dropped. 
+ * Messages with QoS 0 are sent once, messages with QoS 1 are repeated until the broker accepts 
+ * them or MAX_ATTEMPTS is reached.
+ */
+class PublishQueue {
+public:
+    typedef std::function<void(const Message&)> Delivered_t;
+
+    static const uint8_t DEFAULT_DEPTH = 32;
+    static const uint8_t MAX_ATTEMPTS = 3;
+
+    PublishQueue(uint8_t depth = DEFAULT_DEPTH) : _depth(depth), _inFlight(0), _droppedAmount(0) {}
+
+    /**
+     * Sets the maximal amount of messages in the queue, drops the oldest messages not in flight 
+     * if needed
+     * @param depth maximal amount of messages
+     */
+    void setDepth(uint8_t depth);
+
+    /**
+     * Adds a message to the end of the queue. If the queue is full, the oldest message not in 
+     * flight is dropped, or the new message, if all messages are in flight.
+     * @param message message to publish
+     * @param qos quality of service, 0 (at most once) or 1 (at least once)
+     * @param retain if true, the broker will retain the message
+     */
+    void push(const Message& message, uint8_t qos, bool retain);
+
+    /**
+     * Gets the amount of messages at the front of the queue that can be sent in one batch, 
+     * all of them having the same qos and retain settings
+     * @param maxAmount maximal amount of messages in a batch
+     */
+    uint8_t getBatchSize(uint8_t maxAmount) const;
+
+    /**
+     * Gets a message in the queue
+     * @param index position in the queue, 0 is the oldest message
+     */
+    const QueuedMessage& at(uint8_t index) const { return _messages[index]; }
+
+    /**
+     * Marks messages at the front of the queue as sent, they are kept until pop or failed 
+     * is called for them
+     * @param amount amount of messages at the front of the queue
+     */
+    void setInFlight(uint8_t amount) { _inFlight = amount; }
+
+    /**
+     * @returns amount of messages sent and not yet answered by the broker
+     */
+    uint8_t getInFlight() const { return _inFlight; }
+
+    /**
+     * Sets the function called by pop for every message accepted by the broker
+     * @param delivered function to call
+     */
+    void setDeliveredFunction(Delivered_t delivered) { _delivered = delivered; }
+
+    /**
+     * Removes messages accepted by the broker and reports them to the delivered function
+     * @param amount amount of messages at the front of the queue
+     */
+    void pop(uint8_t amount);
+
+    /**
+     * Handles messages not accepted by the broker. QoS 0 messages are dropped, QoS 1 messages
+     * stay in the queue until MAX_ATTEMPTS is reached
+     * @param amount amount of messages at the front of the queue
+     */
+    void failed(uint8_t amount);
+
+    bool isEmpty() const { return _messages.empty(); }
+    uint8_t size() const { return _messages.size(); }
+
+    /**
+     * @returns amount of messages dropped since start
+     */
+    uint16_t getDroppedAmount() const { return _droppedAmount; }
+
+private:
+    /**
+     * Drops the oldest message not in flight
+     * @returns false, if all messages are in flight
+     */
+    bool dropOldest();
+
+    /**
+     * Marks messages at the front of the queue as answered
+     */
+    void answered(uint8_t amount) { _inFlight = amount < _inFlight ? _inFlight - amount : 0; }
+
+    std::deque<QueuedMessage> _messages;
+    Delivered_t _delivered;
+    uint8_t _depth;
+    uint8_t _inFlight;
+    uint16_t _droppedAmount;
+};
@@ -0,0 +1,77 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Samples free heap, largest free block and fragmentation at the start and end of phases
+ */
+
+#define __DEBUG
+#include <debug.h>
+#include "heapmonitor.h"
+
+const char* const HeapMonitor::PHASE_NAMES[PHASE_AMOUNT] = { "setup", "publish", "form", "config" };
+HeapMonitor::PhaseStatistic HeapMonitor::_phases[PHASE_AMOUNT];
+HeapSample HeapMonitor::_lowWaterMark = { UINT32_MAX, UINT32_MAX, 0 };
+
+HeapSample HeapMonitor::sample() {
+    HeapSample result;
+    result.freeHeap = ESP.getFreeHeap();
+    result.maxFreeBlock = ESP.getMaxFreeBlockSize();
+    result.fragmentation = ESP.getHeapFragmentation();
+    return result;
+}
+
+void HeapMonitor::update(const HeapSample& heap) {
+    _lowWaterMark.freeHeap = std::min(_lowWaterMark.freeHeap, heap.freeHeap);
+    _lowWaterMark.maxFreeBlock = std::min(_lowWaterMark.maxFreeBlock, heap.maxFreeBlock);
+    _lowWaterMark.fragmentation = std::max(_lowWaterMark.fragmentation, heap.fragmentation);
+}
+
+void HeapMonitor::begin(Phase phase) {
+    HeapSample heap = sample();
+    PhaseStatistic& statistic = _phases[phase];
+    statistic.startFree = heap.freeHeap;
+    if (statistic.amount == 0 || heap.freeHeap < statistic.minFree) {
+        statistic.minFree = heap.freeHeap;
+    }
+    update(heap);
+}
+
+void HeapMonitor::end(Phase phase) {
+    HeapSample heap = sample();
+    PhaseStatistic& statistic = _phases[phase];
+    int32_t retained = int32_t(statistic.startFree) - int32_t(heap.freeHeap);
+    if (statistic.amount == 0 || retained > statistic.maxRetained) {
+        statistic.maxRetained = retained;
+    }
+    statistic.minFree = std::min(statistic.minFree, heap.freeHeap);
+    statistic.amount++;
+    update(heap);
+}
+
+Messages_t HeapMonitor::getMessages(const String& baseTopic) {
+    const char* reason = "send by yaha ESP8266 module";
+    const String topic = baseTopic + "/diag/heap/";
+    HeapSample heap = sample();
+    update(heap);
+
+    Messages_t result;
+    result.push_back(Message(topic + "free", String(heap.freeHeap), reason));
+    result.push_back(Message(topic + "minFree", String(_lowWaterMark.freeHeap), reason));
+    result.push_back(Message(topic + "minMaxFreeBlock", String(_lowWaterMark.maxFreeBlock), reason));
+    result.push_back(Message(topic + "maxFragmentation", String(_lowWaterMark.fragmentation), reason));
+    for (uint8_t phase = 0; phase < PHASE_AMOUNT; phase++) {
+        const PhaseStatistic& statistic = _phases[phase];
+        if (statistic.amount == 0) {
+            continue;
+        }
+        const String phaseTopic = topic + PHASE_NAMES[phase] + "/";
+        result.push_back(Message(phaseTopic + "minFree", String(statistic.minFree), reason));
+        result.push_back(Message(phaseTopic + "maxRetained", String(statistic.maxRetained), reason));
+    }
+    return result;
+}
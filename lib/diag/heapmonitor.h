@@ -0,0 +1,87 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Samples free heap, largest free block and fragmentation at the start and end of phases and
+ * publishes the low-water marks as diag/heap messages
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <message.h>
+#include <idevice.h>
+
+/**
+ * State of the heap at one point in time
+ */
+struct HeapSample {
+    uint32_t freeHeap;
+    uint32_t maxFreeBlock;
+    uint8_t fragmentation;
+};
+
+class HeapMonitor : public IDevice {
+public:
+    enum Phase { SETUP, PUBLISH, FORM, CONFIG, PHASE_AMOUNT };
+
+    /**
+     * Samples the heap at the start and at the end of its lifetime
+     */
+    class Scope {
+    public:
+        Scope(Phase phase) : _phase(phase) { HeapMonitor::begin(phase); }
+        ~Scope() { HeapMonitor::end(_phase); }
+    private:
+        Phase _phase;
+    };
+
+    /**
+     * Samples the heap at the start of a phase
+     * @param phase phase starting
+     */
+    static void begin(Phase phase);
+
+    /**
+     * Samples the heap at the end of a phase
+     * @param phase phase ending
+     */
+    static void end(Phase phase);
+
+    /**
+     * Reads the current state of the heap
+     */
+    static HeapSample sample();
+
+    /**
+     * Gets the low-water marks since start as messages <baseTopic>/diag/heap/...
+     * @param baseTopic start topic to be used to create the message topic
+     * @returns a list of messages to send with topic, value and reason
+     */
+    virtual Messages_t getMessages(const String& baseTopic);
+
+private:
+    /**
+     * Heap statistic of a phase
+     */
+    struct PhaseStatistic {
+        uint32_t startFree;
+        uint32_t minFree;
+        int32_t maxRetained;
+        uint16_t amount;
+    };
+
+    /**
+     * Updates the overall low-water marks
+     * @param heap current state of the heap
+     */
+    static void update(const HeapSample& heap);
+
+    static const char* const PHASE_NAMES[PHASE_AMOUNT];
+    static PhaseStatistic _phases[PHASE_AMOUNT];
+    static HeapSample _lowWaterMark;
+};
@@ -0,0 +1,30 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Reports the share of time the station is awake between scheduled tasks
+ */
+
+#define __DEBUG
+#include <debug.h>
+#include <scheduler.h>
+#include "powermonitor.h"
+
+Messages_t PowerMonitor::getMessages(const String& baseTopic) {
+    const char* reason = "send by yaha ESP8266 module";
+    const String topic = baseTopic + "/diag/power/";
+    Messages_t result;
+    Scheduler::Statistic statistic = Scheduler::getStatistic(true);
+    if (statistic.time == 0) {
+        return result;
+    }
+    float awake = 100.0 * (statistic.time - std::min(statistic.sleepTime, statistic.time)) / statistic.time;
+    float wakeupsPerSecond = 1000.0 * statistic.wakeups / statistic.time;
+    result.push_back(Message(topic + "awakePercent", String(awake, 1), reason));
+    result.push_back(Message(topic + "wakeupsPerSecond", String(wakeupsPerSecond, 1), reason));
+    return result;
+}
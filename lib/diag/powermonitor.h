@@ -0,0 +1,29 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Reports the share of time the station is awake between scheduled tasks as proxy for the
+ * current draw in mains mode
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <message.h>
+#include <idevice.h>
+
+class PowerMonitor : public IDevice {
+public:
+    /**
+     * Gets the statistic of the scheduler since the last call as messages 
+     * <baseTopic>/diag/power/{awakePercent,wakeupsPerSecond}. The station is awake, while it 
+     * runs tasks and the idle function, and between the wakeups from sleep.
+     * @param baseTopic start topic to be used to create the message topic
+     * @returns a list of messages to send with topic, value and reason
+     */
+    virtual Messages_t getMessages(const String& baseTopic);
+};
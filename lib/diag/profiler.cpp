@@ -0,0 +1,118 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Measures the time spent in the phases of a wake cycle
+ */
+
+#define __DEBUG
+#include <debug.h>
+#include <rtcmem.h>
+#include "profiler.h"
+
+const char* const Profiler::SPAN_NAMES[DEVICE_RUN] = {
+    "total", "eeprom", "wlan", "broker", "subscribe", "publish", "wait", "disconnect"
+};
+Profiler::RTCProfile Profiler::_profile;
+bool Profiler::_isLoaded = false;
+uint32_t Profiler::_start[SPAN_AMOUNT];
+uint32_t Profiler::_current[SPAN_AMOUNT];
+uint32_t Profiler::_cycleStart = 0;
+
+void Profiler::load() {
+    if (_isLoaded) {
+        return;
+    }
+    static_assert(RTCMem<RTCProfile>::getBlockAmount() <= RTC_WLAN_BLOCK - RTC_PROFILE_BLOCK,
+        "RTCProfile does not fit into its RTC memory blocks");
+    _profile = RTCMem<RTCProfile>::read(RTC_PROFILE_BLOCK);
+    if (_profile.magic != MAGIC_NUMBER) {
+        memset(&_profile, 0, sizeof(_profile));
+        _profile.magic = MAGIC_NUMBER;
+    }
+    _isLoaded = true;
+}
+
+void Profiler::begin(Span span) {
+    load();
+    _start[span] = micros();
+}
+
+void Profiler::end(Span span) {
+    _current[span] += micros() - _start[span];
+}
+
+uint8_t Profiler::getBucket(uint32_t durationInMicroseconds) {
+    uint32_t limit = 250000;
+    uint8_t bucket = 0;
+    while (bucket < HISTOGRAM_BUCKETS - 1 && durationInMicroseconds >= limit) {
+        limit *= 2;
+        bucket++;
+    }
+    return bucket;
+}
+
+void Profiler::endCycle() {
+    load();
+    uint32_t now = micros();
+    _current[TOTAL] = now - _cycleStart;
+    for (uint8_t span = 0; span < SPAN_AMOUNT; span++) {
+        _profile.last[span] = _current[span];
+        if (_profile.cycles == 0) {
+            _profile.average[span] = _current[span];
+        } else {
+            // Exponential moving average with a weight of 1/8 for the new value
+            int32_t difference = int32_t(_current[span] - _profile.average[span]);
+            _profile.average[span] += difference / 8;
+        }
+        _current[span] = 0;
+    }
+    uint16_t& bucket = _profile.histogram[getBucket(_profile.last[TOTAL])];
+    if (bucket < UINT16_MAX) {
+        bucket++;
+    }
+    _profile.cycles++;
+    RTCMem<RTCProfile>::write(RTC_PROFILE_BLOCK, _profile);
+    _cycleStart = now;
+}
+
+String Profiler::getSpanName(uint8_t span) {
+    if (span < DEVICE_RUN) {
+        return SPAN_NAMES[span];
+    }
+    return "run" + String(span - DEVICE_RUN);
+}
+
+Messages_t Profiler::getMessages(const String& baseTopic) {
+    const float MICROSECONDS_IN_A_MILLISECOND = 1000;
+    Messages_t result;
+    load();
+    if (_profile.cycles == 0) {
+        return result;
+    }
+    String value = "n=" + String(_profile.cycles);
+    for (uint8_t span = 0; span < SPAN_AMOUNT; span++) {
+        if (_profile.last[span] == 0 && _profile.average[span] == 0) {
+            continue;
+        }
+        value += ' ';
+        value += getSpanName(span);
+        value += '=';
+        value += String(_profile.last[span] / MICROSECONDS_IN_A_MILLISECOND, 1);
+        value += '/';
+        value += String(_profile.average[span] / MICROSECONDS_IN_A_MILLISECOND, 1);
+    }
+    value += " hist=";
+    for (uint8_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+        if (bucket > 0) {
+            value += '/';
+        }
+        value += String(_profile.histogram[bucket]);
+    }
+    result.push_back(Message(baseTopic + "/diag/profile", value, "send by yaha ESP8266 module"));
+    return result;
+}
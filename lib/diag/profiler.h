@@ -0,0 +1,109 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Measures the time spent in the phases of a wake cycle. The timings of the last cycle, their
+ * moving average and a histogram of the cycle duration are kept in RTC memory across deep sleep.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <message.h>
+#include <idevice.h>
+
+class Profiler : public IDevice {
+public:
+    static const uint8_t MAX_DEVICE_SPANS = 4;
+    static const uint8_t HISTOGRAM_BUCKETS = 8;
+
+    enum Span {
+        TOTAL, EEPROM_READ, WLAN_CONNECT, BROKER_CONNECT, SUBSCRIBE, PUBLISH, WAIT, DISCONNECT,
+        DEVICE_RUN, SPAN_AMOUNT = DEVICE_RUN + MAX_DEVICE_SPANS
+    };
+
+    /**
+     * Measures the time from construction to destruction
+     */
+    class Scope {
+    public:
+        Scope(Span span) : _span(span) { Profiler::begin(span); }
+        ~Scope() { Profiler::end(_span); }
+    private:
+        Span _span;
+    };
+
+    /**
+     * Starts measuring a span
+     * @param span span to measure
+     */
+    static void begin(Span span);
+
+    /**
+     * Stops measuring a span, the time is added to the time of the span in the current cycle
+     * @param span span to measure
+     */
+    static void end(Span span);
+
+    /**
+     * Gets the span measuring the run function of a device. Devices beyond MAX_DEVICE_SPANS share
+     * the last span.
+     * @param deviceIndex index of the device
+     */
+    static Span getDeviceSpan(uint8_t deviceIndex) {
+        return Span(DEVICE_RUN + std::min(deviceIndex, uint8_t(MAX_DEVICE_SPANS - 1)));
+    }
+
+    /**
+     * Ends the current wake cycle and stores its timings to RTC memory. Call it right before deep
+     * sleep or at the end of a loop in permanent mode.
+     */
+    static void endCycle();
+
+    /**
+     * Gets the timings of the previous cycle as message <baseTopic>/diag/profile with the value
+     * "n=<cycles> <span>=<last ms>/<average ms> ... hist=<count>/<count>/..."
+     * @param baseTopic start topic to be used to create the message topic
+     * @returns a list of messages to send with topic, value and reason
+     */
+    virtual Messages_t getMessages(const String& baseTopic);
+
+private:
+    /**
+     * Timings kept in RTC memory, all times in microseconds
+     */
+    struct RTCProfile {
+        uint32_t magic;
+        uint32_t cycles;
+        uint32_t last[SPAN_AMOUNT];
+        uint32_t average[SPAN_AMOUNT];
+        uint16_t histogram[HISTOGRAM_BUCKETS];
+    };
+
+    /**
+     * Reads the profile from RTC memory on first use, initializes it if it is not valid
+     */
+    static void load();
+
+    /**
+     * @returns histogram bucket of a cycle duration, bucket i covers up to 250 ms * 2^i
+     */
+    static uint8_t getBucket(uint32_t durationInMicroseconds);
+
+    /**
+     * @returns name of a span used in the message
+     */
+    static String getSpanName(uint8_t span);
+
+    static const uint32_t MAGIC_NUMBER = 0x50524F00 | SPAN_AMOUNT;
+    static const char* const SPAN_NAMES[DEVICE_RUN];
+    static RTCProfile _profile;
+    static bool _isLoaded;
+    static uint32_t _start[SPAN_AMOUNT];
+    static uint32_t _current[SPAN_AMOUNT];
+    static uint32_t _cycleStart;
+};
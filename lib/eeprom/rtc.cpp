@@ -11,30 +11,15 @@
 #define __DEBUG
 #include "debug.h"
 #include "rtc.h"
+#include "rtcmem.h"
 
 const uint32_t MAGIC_NUMBER = 0xAABBCCDD;
-const int16_t MAGIC_NUMBER_ADDR = 0;
-const int16_t WAKEUP_COUNTER_ADDR = 1;
-const int16_t START_TYPE_ADDR = 2;
+const int16_t MAGIC_NUMBER_ADDR = RTC_MAGIC_NUMBER_BLOCK;
+const int16_t WAKEUP_COUNTER_ADDR = RTC_WAKEUP_COUNTER_BLOCK;
+const int16_t START_TYPE_ADDR = RTC_START_TYPE_BLOCK;
 const int16_t NORMAL_RESET = 0;
 const int16_t FAST_RESET = 1;
 
-template <class T>
-class RTCMem {
-public:
-    static T read(uint16_t addr) {
-        T result;
-        system_rtc_mem_read(RTC_USER_DATA_ADDR + addr, &result, sizeof(result));
-        return result;  
-    }
-
-    static void write(uint16_t addr, T data) {
-        system_rtc_mem_write(RTC_USER_DATA_ADDR + addr, &data, sizeof(data));
-    }
-
-    static const uint16_t RTC_USER_DATA_ADDR = 65;
-};
-
 /**
  * Gets configuration as key/value map
  * @returns configuration 
@@ -0,0 +1,66 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Typed access to the RTC user memory, which survives deep sleep but not power loss
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#ifdef ESP8266
+extern "C" {
+#include "user_interface.h"
+}
+#endif
+
+/**
+ * Block map of the RTC user memory. Addresses are in 4 byte blocks relative to
+ * RTCMem::RTC_USER_DATA_ADDR, the user memory has 127 blocks behind it.
+ */
+enum RTCMemBlock : uint16_t {
+    RTC_MAGIC_NUMBER_BLOCK = 0,
+    RTC_WAKEUP_COUNTER_BLOCK = 1,
+    RTC_START_TYPE_BLOCK = 2,
+    // WLAN wakes since the last RF calibration, 1 block
+    RTC_RADIO_BLOCK = 3,
+    // Profiler::RTCProfile, 32 blocks
+    RTC_PROFILE_BLOCK = 4,
+    // WLAN::RTCConnection, 8 blocks
+    RTC_WLAN_BLOCK = 36,
+    // SleepPlanner::RTCHistory, 14 blocks
+    RTC_SLEEP_BLOCK = 44,
+    // SampleBuffer::RTCBuffer, 66 blocks
+    RTC_SAMPLE_BLOCK = 58,
+    RTC_FREE_BLOCK = 124
+};
+
+/**
+ * Reads and writes values to the RTC user memory. The size of T should be a multiple of 4 bytes,
+ * the SDK always transfers full blocks.
+ */
+template <class T>
+class RTCMem {
+public:
+    static T read(uint16_t addr) {
+        T result;
+        system_rtc_mem_read(RTC_USER_DATA_ADDR + addr, &result, sizeof(result));
+        return result;
+    }
+
+    static void write(uint16_t addr, const T& data) {
+        system_rtc_mem_write(RTC_USER_DATA_ADDR + addr, &data, sizeof(data));
+    }
+
+    /**
+     * @returns amount of 4 byte blocks used by T
+     */
+    static constexpr uint16_t getBlockAmount() { return (sizeof(T) + 3) / 4; }
+
+    static const uint16_t RTC_USER_DATA_ADDR = 65;
+};
@@ -20,49 +20,26 @@ Irrigation::Configuration::Configuration() {
         pump2Factor = 1;
 }
 
-std::map<String, String> Irrigation::Configuration::get()
+Properties Irrigation::Configuration::get()
 {
-    std::map<String, String> result;
-    result["irrigation/lowDurationInSeconds"] = lowDurationInSeconds;
-    result["irrigation/lowWakeup"] = lowWakeup;
-    result["irrigation/highDurationInSeconds"] = highDurationInSeconds;
-    result["irrigation/highWakeup"] = highWakeup;
-    result["irrigation/pump2Factor"] = pump2Factor;
+    Properties result;
+    result.set(StaticKey("irrigation/lowDurationInSeconds"), String(lowDurationInSeconds));
+    result.set(StaticKey("irrigation/lowWakeup"), String(lowWakeup));
+    result.set(StaticKey("irrigation/highDurationInSeconds"), String(highDurationInSeconds));
+    result.set(StaticKey("irrigation/highWakeup"), String(highWakeup));
+    result.set(StaticKey("irrigation/pump2Factor"), String(pump2Factor));
     return result;
 }
 
-void Irrigation::Configuration::set(std::map<String, String> config)
+void Irrigation::Configuration::set(const Properties& config)
 {
-    lowDurationInSeconds = config["irrigation/lowDurationInSeconds"].toInt();
-    lowWakeup = config["irrigation/lowWakeup"].toInt();
-    highDurationInSeconds = config["irrigation/highDurationInSeconds"].toInt();
-    highWakeup = config["irrigation/highWakeup"].toInt();
-    pump2Factor = config["irrigation/pump2Factor"].toFloat();
+    lowDurationInSeconds = config.get("irrigation/lowDurationInSeconds").toInt();
+    lowWakeup = config.get("irrigation/lowWakeup").toInt();
+    highDurationInSeconds = config.get("irrigation/highDurationInSeconds").toInt();
+    highWakeup = config.get("irrigation/highWakeup").toInt();
+    pump2Factor = config.get("irrigation/pump2Factor").toFloat();
 }
 
-const char* Irrigation::htmlForm = 
-    R"htmlform(
-    <form action="/irrigation" method="POST">
-    <label for="Humidity">Current humidity</label>
-    <input type="text" id="Humidity" [value]="sensor/humidity">
-
-    <label for="lowDuration">Low humidity irrigation duration in seconds (30% rH)</label>
-    <input type="text" id="lowDuration" name="irrigation/lowDurationInSeconds" [value]="irrigation/lowDurationInSeconds">
-    <label for="lowWakeup">Low humidity amount of wakeups until irrigation (30% rH)</label>
-    <input type="text" id="lowWakeup" name="irrigation/lowWakeup" [value]="irrigation/lowWakeup">
-
-    <label for="highDuration">High humidity irrigation duration in seconds (60% rH)</label>
-    <input type="text" id="highDuration" name="irrigation/highDurationInSeconds" [value]="irrigation/highDurationInSeconds">
-    <label for="highWakeup">High humidity amount of wakeups until irrigation (60% rH)</label>
-    <input type="text" id="highWakeup" name="irrigation/highWakeup" [value]="irrigation/highWakeup">
-
-    <label for="pump2Factor">Duration factor for pump 2</label>
-    <input type="text" id="pump2Factor" name="irrigation/pump2Factor" [value]="irrigation/pump2Factor">
-
-    <input type="submit" value="Submit">
-    </form>
-    )htmlform";
-
 const char* swithPumpForm = 
     R"htmlswitch(
     
@@ -95,7 +72,7 @@ Messages_t Irrigation::getMessages(const String& baseTopic) {
     return result;
 }
 
-void Irrigation::setConfig(jsonObject_t& config) { 
+void Irrigation::setConfig(const Properties& config) { 
     _config.set(config); 
 };
 
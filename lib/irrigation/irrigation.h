@@ -12,8 +12,9 @@
 
 #include <Arduino.h>
 #include <message.h>
-#include <map>
+#include <properties.h>
 #include <idevice.h>
+#include <assets.h>
 
 class Irrigation : public IDevice
 {
@@ -30,13 +31,13 @@ public:
         /**
          * Gets the config as key/value map
          */
-        std::map<String, String> get();
+        Properties get();
 
         /**
          * Sets the configuration from a key/value map
          * @param config config settings in a map
          */
-        void set(std::map<String, String> config);
+        void set(const Properties& config);
     };
     Irrigation(uint8_t pump1Pin = D6, uint8_t pump2Pin = D7); 
 
@@ -44,13 +45,13 @@ public:
      * Sets configuration from a key/value map
      * @param config map containing the configuration
      */
-    virtual void setConfig(jsonObject_t& config);
+    virtual void setConfig(const Properties& config);
     
     /**
      * Gets configuration as key/value map
      * @returns configuration 
      */
-    virtual jsonObject_t getConfig() { return _config.get(); };
+    virtual Properties getConfig() { return _config.get(); };
 
     /**
      * Writes the configuration to EEPROM
@@ -97,7 +98,7 @@ public:
     /**
      * Gets an info about the matching html page
      */
-    virtual HtmlPageInfo getHtmlPage() { return HtmlPageInfo(htmlForm, "/irrigation", "Irrigation"); }
+    virtual HtmlPageInfo getHtmlPage() { return HtmlPageInfo(irrigationForm, "/irrigation", "Irrigation"); }
 
 
 private:
@@ -113,5 +114,4 @@ private:
     uint8_t _pump2Pin;
     float _humidity;
     uint16_t _wakeupAmount;
-    static const char* htmlForm;
 };
\ No newline at end of file
@@ -11,6 +11,13 @@
 #include <debug.h>
 #include "motion.h"
 
+extern "C" {
+#include "user_interface.h"
+#ifdef ESP8266
+#include "gpio.h"
+#endif
+}
+
 bool Motion::motion1;
 bool Motion::motion2;
 bool Motion::motion3;
@@ -31,6 +38,20 @@ Motion::Motion(){
     motion3 = digitalRead(D7) == HIGH;
 }
 
+void Motion::beforeLightSleep() {
+    // The level wake replaces the RISING interrupt of the pin until afterLightSleep
+    gpio_pin_wakeup_enable(D5, GPIO_PIN_INTR_HILEVEL);
+}
+
+void Motion::afterLightSleep() {
+    gpio_pin_wakeup_disable();
+    attachInterrupt(digitalPinToInterrupt(D5), motionD5, RISING);
+    // The rising edge that woke the station is not seen by the restored interrupt
+    if (digitalRead(D5) == HIGH) {
+        motion1 = true;
+    }
+}
+
 Messages_t Motion::getMessages(const String& baseTopic) {
     std::vector<Message> result;
     bool motion = motion1 || motion2 || motion3;
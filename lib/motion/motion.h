@@ -24,6 +24,21 @@ public:
      */
     virtual Messages_t getMessages(const String &baseTopic);
 
+    /**
+     * @returns true, if a motion has been detected since the last publish
+     */
+    virtual bool hasPendingMessages() { return motion1 || motion2 || motion3; }
+
+    /**
+     * Lets a high level on D5 wake the station, the SDK supports only one wake pin
+     */
+    virtual void beforeLightSleep();
+
+    /**
+     * Disables the wake pin and restores the motion interrupt of D5
+     */
+    virtual void afterLightSleep();
+
     static bool motion1;
     static bool motion2;
     static bool motion3;
@@ -0,0 +1,143 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Stores sensor samples of wakes without WLAN connection in RTC memory
+ */
+
+#define __DEBUG
+#include <debug.h>
+#include <rtcmem.h>
+#include "samplebuffer.h"
+
+void SampleBuffer::load() {
+    if (_isLoaded) {
+        return;
+    }
+    static_assert(RTCMem<RTCBuffer>::getBlockAmount() <= RTC_FREE_BLOCK - RTC_SAMPLE_BLOCK,
+        "RTCBuffer does not fit into its RTC memory blocks");
+    _buffer = RTCMem<RTCBuffer>::read(RTC_SAMPLE_BLOCK);
+    if (_buffer.magic != MAGIC_NUMBER || _buffer.first >= CAPACITY || _buffer.amount > CAPACITY) {
+        memset(&_buffer, 0, sizeof(_buffer));
+        _buffer.magic = MAGIC_NUMBER;
+        _buffer.uploaded.temperature = NO_TEMPERATURE;
+    }
+    memset(&_current, 0, sizeof(_current));
+    _current.temperature = NO_TEMPERATURE;
+    _isLoaded = true;
+}
+
+bool SampleBuffer::isSamplingWake() {
+    if (!isEnabled()) {
+        return false;
+    }
+    load();
+    bool isDeepSleepAwake = ESP.getResetInfoPtr()->reason == REASON_DEEP_SLEEP_AWAKE;
+    return _buffer.isNextSampling && isDeepSleepAwake && !_isThresholdTripped;
+}
+
+void SampleBuffer::handleMessage(const String& key, const String& value) {
+    load();
+    if (key == "sensor/temperature") {
+        _current.temperature = int16_t(value.toFloat() * 100);
+    } else if (key == "sensor/humidity") {
+        _current.humidity = uint16_t(value.toFloat() * 100);
+    } else if (key == "sensor/pressure") {
+        // The sensor reports Pa
+        _current.pressure = uint16_t(value.toFloat() / 10);
+    } else if (key == "battery/voltage") {
+        _current.voltage = uint16_t(value.toFloat() * 1000);
+    } else {
+        return;
+    }
+    if (!_isThresholdTripped && isThresholdExceeded()) {
+        PRINTLN_IF_DEBUG("Sample threshold exceeded, connecting")
+        _isThresholdTripped = true;
+    }
+}
+
+bool SampleBuffer::isThresholdExceeded() const {
+    const Sample& uploaded = _buffer.uploaded;
+    if (_current.temperature != NO_TEMPERATURE && uploaded.temperature != NO_TEMPERATURE &&
+        abs(_current.temperature - uploaded.temperature) >= TEMPERATURE_THRESHOLD) 
+    {
+        return true;
+    }
+    return _current.humidity != 0 && uploaded.humidity != 0 && 
+        abs(int32_t(_current.humidity) - int32_t(uploaded.humidity)) >= HUMIDITY_THRESHOLD;
+}
+
+void SampleBuffer::writeSample(const Sample& sample, uint32_t ageInSeconds, JSONWriter& json) {
+    json.beginObject().numberProperty("ageInSeconds", ageInSeconds);
+    if (sample.temperature != NO_TEMPERATURE) {
+        json.rawProperty("temperature", String(sample.temperature / 100.0, 2).c_str());
+    }
+    if (sample.humidity != 0) {
+        json.rawProperty("humidity", String(sample.humidity / 100.0, 2).c_str());
+    }
+    if (sample.pressure != 0) {
+        json.rawProperty("pressure", String(sample.pressure / 10.0, 1).c_str());
+    }
+    if (sample.voltage != 0) {
+        json.rawProperty("voltage", String(sample.voltage / 1000.0, 3).c_str());
+    }
+    json.endObject();
+}
+
+Messages_t SampleBuffer::getMessages(const String& baseTopic) {
+    const uint32_t MILLISECONDS_IN_A_SECOND = 1000;
+    Messages_t result;
+    load();
+    if (_buffer.amount == 0) {
+        return result;
+    }
+    String value = jsonToString([this](JSONWriter& json) {
+        uint32_t ageInSeconds = _buffer.secondsSinceLastSample + millis() / MILLISECONDS_IN_A_SECOND;
+        json.beginArray();
+        for (uint8_t i = _buffer.amount; i > 0; i--) {
+            const Sample& sample = _buffer.samples[(_buffer.first + i - 1) % CAPACITY];
+            writeSample(sample, ageInSeconds, json);
+            ageInSeconds += sample.timeDelta;
+        }
+        json.endArray();
+    });
+    result.push_back(Message(baseTopic + "/sensor/samples", value, "send by yaha ESP8266 module"));
+    return result;
+}
+
+void SampleBuffer::store(uint16_t sleepTimeInSeconds, bool isUploaded) {
+    const uint32_t MILLISECONDS_IN_A_SECOND = 1000;
+    if (!isEnabled()) {
+        return;
+    }
+    load();
+    _buffer.secondsSinceLastSample += millis() / MILLISECONDS_IN_A_SECOND;
+    if (isUploaded) {
+        _buffer.first = 0;
+        _buffer.amount = 0;
+        _buffer.wakesSinceUpload = 0;
+        _buffer.uploaded = _current;
+    } else {
+        Sample& sample = _buffer.samples[(_buffer.first + _buffer.amount) % CAPACITY];
+        sample = _current;
+        sample.timeDelta = std::min(_buffer.secondsSinceLastSample, uint32_t(UINT16_MAX));
+        if (_buffer.amount < CAPACITY) {
+            _buffer.amount++;
+        } else {
+            // Overwrites the oldest sample, if uploads failed
+            _buffer.first = (_buffer.first + 1) % CAPACITY;
+        }
+        if (_buffer.wakesSinceUpload < UINT8_MAX) {
+            _buffer.wakesSinceUpload++;
+        }
+    }
+    _buffer.secondsSinceLastSample = sleepTimeInSeconds;
+    _buffer.isNextSampling = !_isThresholdTripped && _buffer.wakesSinceUpload + 1 < _uploadInterval && 
+        _buffer.amount < CAPACITY;
+    PRINTLN_VARIABLE_IF_DEBUG(_buffer.amount)
+    RTCMem<RTCBuffer>::write(RTC_SAMPLE_BLOCK, _buffer);
+}
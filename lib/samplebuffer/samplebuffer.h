@@ -0,0 +1,129 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Stores sensor samples of wakes without WLAN connection in RTC memory and uploads them in one
+ * batch on the next wake with connection
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <message.h>
+#include <idevice.h>
+#include <jsonwriter.h>
+
+class SampleBuffer : public IDevice {
+public:
+    static const uint8_t CAPACITY = 24;
+
+    SampleBuffer() : _uploadInterval(0), _isLoaded(false), _isThresholdTripped(false) {}
+
+    /**
+     * Enables sampling wakes
+     * @param uploadInterval every uploadInterval'th wake connects to upload the samples
+     */
+    void setUploadInterval(uint8_t uploadInterval) { _uploadInterval = uploadInterval; }
+
+    /**
+     * @returns true, if sampling wakes are enabled
+     */
+    bool isEnabled() const { return _uploadInterval > 1; }
+
+    /**
+     * Checks, if the current wake only samples the sensors without connecting. This is decided 
+     * on the previous wake, a wake after reset or power on is never a sampling wake. The wake 
+     * turns into a connecting wake, if a sensor value changed more than a threshold since the
+     * last upload.
+     * @returns true, if the current wake does not connect
+     */
+    bool isSamplingWake();
+
+    /**
+     * @returns true, if the next wake only samples, valid after store
+     */
+    bool isNextSampling() {
+        load();
+        return isEnabled() && _buffer.isNextSampling;
+    }
+
+    /**
+     * Collects the sensor values of the current wake
+     * @param key message identifier
+     * @param value message value
+     */
+    virtual void handleMessage(const String& key, const String& value);
+
+    /**
+     * Gets the stored samples as message <baseTopic>/sensor/samples. The value is a JSON array 
+     * of {"ageInSeconds", "temperature", "humidity", "pressure", "voltage"} objects, newest first.
+     * @param baseTopic start topic to be used to create the message topic
+     * @returns a list of messages to send with topic, value and reason
+     */
+    virtual Messages_t getMessages(const String& baseTopic);
+
+    /**
+     * Clears the uploaded samples or stores the sample of this wake, if it did not upload, and 
+     * decides, if the next wake samples or connects. Call it right before deep sleep.
+     * @param sleepTimeInSeconds time until the next wake
+     * @param isUploaded true, if the samples and current values have been sent on this wake
+     */
+    void store(uint16_t sleepTimeInSeconds, bool isUploaded);
+
+private:
+    // Changes since the last upload, which require a connect
+    static const int16_t TEMPERATURE_THRESHOLD = 100;
+    static const uint16_t HUMIDITY_THRESHOLD = 500;
+    static const int16_t NO_TEMPERATURE = INT16_MIN;
+
+    /**
+     * Sample in RTC memory: seconds since the previous sample, temperature in 1/100 °C, humidity 
+     * in 1/100 %, pressure in 1/10 hPa, voltage in mV. Missing values are 0, missing temperature
+     * is NO_TEMPERATURE.
+     */
+    struct Sample {
+        uint16_t timeDelta;
+        int16_t temperature;
+        uint16_t humidity;
+        uint16_t pressure;
+        uint16_t voltage;
+    };
+
+    struct RTCBuffer {
+        uint32_t magic;
+        uint32_t secondsSinceLastSample;
+        uint8_t first;
+        uint8_t amount;
+        uint8_t wakesSinceUpload;
+        uint8_t isNextSampling;
+        Sample uploaded;
+        uint16_t reserved;
+        Sample samples[CAPACITY];
+    };
+
+    /**
+     * Reads the buffer from RTC memory on first use, initializes it if it is not valid
+     */
+    void load();
+
+    /**
+     * @returns true, if a value changed more than its threshold since the last upload
+     */
+    bool isThresholdExceeded() const;
+
+    /**
+     * Writes a sample as JSON object
+     */
+    static void writeSample(const Sample& sample, uint32_t ageInSeconds, JSONWriter& json);
+
+    static const uint32_t MAGIC_NUMBER = 0x53424600 | CAPACITY;
+    uint8_t _uploadInterval;
+    bool _isLoaded;
+    bool _isThresholdTripped;
+    Sample _current;
+    RTCBuffer _buffer;
+};
@@ -0,0 +1,85 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Cooperative scheduler running periodic tasks in the order of their deadlines
+ */
+
+#define __DEBUG
+#include <debug.h>
+#include "scheduler.h"
+
+std::vector<Scheduler::Task> Scheduler::_tasks;
+Scheduler::Task_t Scheduler::_idle;
+Scheduler::Task_t Scheduler::_beforeSleep;
+Scheduler::Task_t Scheduler::_afterSleep;
+uint32_t Scheduler::_idleInterval = Scheduler::DEFAULT_IDLE_INTERVAL;
+Scheduler::Statistic Scheduler::_statistic;
+uint32_t Scheduler::_statisticStart = 0;
+
+void Scheduler::addTask(Task_t task, uint32_t intervalInMilliseconds, uint32_t delayInMilliseconds) {
+    uint32_t due = millis() + delayInMilliseconds;
+    _tasks.push_back(Task{ task, intervalInMilliseconds, due });
+}
+
+Scheduler::Statistic Scheduler::getStatistic(bool reset) {
+    uint32_t now = millis();
+    Statistic result = _statistic;
+    result.time = now - _statisticStart;
+    if (reset) {
+        _statistic = Statistic();
+        _statisticStart = now;
+    }
+    return result;
+}
+
+uint8_t Scheduler::getNextTask() {
+    uint8_t result = 0;
+    for (uint8_t i = 1; i < _tasks.size(); i++) {
+        if (isBefore(_tasks[i].due, _tasks[result].due)) {
+            result = i;
+        }
+    }
+    return result;
+}
+
+void Scheduler::runFor(uint32_t durationInMilliseconds) {
+    uint32_t end = millis() + durationInMilliseconds;
+    while (isBefore(millis(), end)) {
+        uint32_t now = millis();
+        uint32_t nextDue = end;
+        if (!_tasks.empty()) {
+            Task& task = _tasks[getNextTask()];
+            if (!isBefore(now, task.due)) {
+                // Skips missed periods instead of running the task several times in a row
+                task.due = isBefore(now, task.due + task.interval) ? task.due + task.interval : now + task.interval;
+                task.function();
+                continue;
+            }
+            nextDue = isBefore(task.due, end) ? task.due : end;
+        }
+        if (_idle) {
+            _idle();
+        }
+        now = millis();
+        if (isBefore(now, nextDue)) {
+            // The SDK sleeps in delay, if a sleep mode is set
+            uint32_t sleepTime = std::min(nextDue - now, _idleInterval);
+            if (_beforeSleep) {
+                _beforeSleep();
+            }
+            delay(sleepTime);
+            if (_afterSleep) {
+                _afterSleep();
+            }
+            _statistic.sleepTime += millis() - now;
+            _statistic.wakeups++;
+        } else {
+            yield();
+        }
+    }
+}
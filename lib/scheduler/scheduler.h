@@ -0,0 +1,118 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Cooperative scheduler running periodic tasks in the order of their deadlines. The time between
+ * two deadlines is spent in an idle function, e.g. to serve http requests.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+#include <vector>
+
+class Scheduler {
+public:
+    typedef std::function<void()> Task_t;
+
+    /**
+     * Default of the maximal time in milliseconds between two calls of the idle function
+     */
+    static const uint32_t DEFAULT_IDLE_INTERVAL = 10;
+
+    /**
+     * Time since the start of the statistic and the part of it spent in delay by runFor, all 
+     * times in milliseconds
+     */
+    struct Statistic {
+        uint32_t time;
+        uint32_t sleepTime;
+        uint32_t wakeups;
+    };
+
+    /**
+     * Adds a periodic task
+     * @param task function to call
+     * @param intervalInMilliseconds time between two calls
+     * @param delayInMilliseconds time until the first call
+     */
+    static void addTask(Task_t task, uint32_t intervalInMilliseconds, uint32_t delayInMilliseconds = 0);
+
+    /**
+     * Sets the function called while no task is due
+     * @param idle function to call
+     */
+    static void setIdleFunction(Task_t idle) { _idle = idle; }
+
+    /**
+     * Sets the maximal time between two calls of the idle function. Longer intervals let the 
+     * station sleep longer, but delay the answer to http requests.
+     * @param intervalInMilliseconds maximal time between two calls
+     */
+    static void setIdleInterval(uint32_t intervalInMilliseconds) { _idleInterval = intervalInMilliseconds; }
+
+    /**
+     * @returns maximal time between two calls of the idle function in milliseconds
+     */
+    static uint32_t getIdleInterval() { return _idleInterval; }
+
+    /**
+     * Sets the functions called around every sleep in delay, e.g. to arm wake up sources only 
+     * while the station sleeps
+     * @param beforeSleep function to call before the sleep
+     * @param afterSleep function to call after waking up
+     */
+    static void setSleepFunctions(Task_t beforeSleep, Task_t afterSleep) { 
+        _beforeSleep = beforeSleep; 
+        _afterSleep = afterSleep; 
+    }
+
+    /**
+     * Gets the time since the last reset and the part of it spent in delay, where the station 
+     * sleeps, if a sleep mode is set
+     * @param reset true to restart the statistic
+     * @returns statistic since the last reset
+     */
+    static Statistic getStatistic(bool reset = false);
+
+    /**
+     * Runs due tasks and the idle function for a time
+     * @param durationInMilliseconds time to run
+     */
+    static void runFor(uint32_t durationInMilliseconds);
+
+    /**
+     * Removes all tasks
+     */
+    static void clear() { _tasks.clear(); }
+
+private:
+    struct Task {
+        Task_t function;
+        uint32_t interval;
+        uint32_t due;
+    };
+
+    /**
+     * @returns true, if the deadline a is before the deadline b, handles the overflow of millis()
+     */
+    static bool isBefore(uint32_t a, uint32_t b) { return int32_t(a - b) < 0; }
+
+    /**
+     * @returns index of the task with the earliest deadline
+     */
+    static uint8_t getNextTask();
+
+    static std::vector<Task> _tasks;
+    static Task_t _idle;
+    static Task_t _beforeSleep;
+    static Task_t _afterSleep;
+    static uint32_t _idleInterval;
+    static Statistic _statistic;
+    static uint32_t _statisticStart;
+};
@@ -27,16 +27,7 @@ void DigitalSensor::init()
 }
 
 HtmlPageInfo DigitalSensor::getHtmlPage() {
-    return HtmlPageInfo(
-        R"htmldigital(
-        <form>
-        <label for="rain">Rain</label>
-        <input type="text" id="rain" readonly [value]="sensor/rain">
-        </form>
-        )htmldigital",
-        "/digital",
-        "Digital"
-    );
+    return HtmlPageInfo(digitalsensorForm, "/digital", "Digital");
 }
 
 void DigitalSensor::run() {
@@ -14,6 +14,7 @@
 
 #include <Arduino.h>
 #include <idevice.h>
+#include <assets.h>
 
 class DigitalSensor : public IDevice
 {
@@ -60,7 +61,6 @@ public:
      */
     virtual bool isValid() const { return true; };
 
-
 private:
 
     /**
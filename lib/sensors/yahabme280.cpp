@@ -54,22 +54,7 @@ float YahaBME280::readPressure()
 }
 
 HtmlPageInfo YahaBME280::getHtmlPage() {
-    return HtmlPageInfo(
-        R"htmlweather(
-        <form>
-        <label for="temperature">Temperature</label>
-        <input type="text" id="temperature" readonly [value]="sensor/temperature">
-        <label for="humidity">Humidity</label>
-        <input type="text" id="humidity" readonly [value]="sensor/humidity">
-        <label for="pressure">Barometric pressure</label>
-        <input type="text" id="pressure" readonly [value]="sensor/pressure">
-        <label for="battery">Battery voltage</label>
-        <input type="text" id="voltage" readonly [value]="battery/voltage">
-        </form>
-        )htmlweather",
-        "/weather",
-        "Weather"
-    );
+    return HtmlPageInfo(weatherForm, "/weather", "Weather");
 }
 
 void YahaBME280::run() {
@@ -16,6 +16,7 @@
 #include <Adafruit_Sensor.h>
 #include <Adafruit_BME280.h>
 #include <idevice.h>
+#include <assets.h>
 
 class YahaBME280 : public IDevice
 {
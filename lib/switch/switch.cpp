@@ -11,30 +11,6 @@
 #include "debug.h"
 #include "switch.h"
 
-const char* Switch::htmlForm = 
-    R"htmlform(
-    <form action="/switch" method="POST">
-    <label class="tb">D4, GPIO12</label>
-    <input type="hidden" name="switch/D4" id="D4" value="toggle">
-    <input type="submit" class="tb" [value]="switch/D4">
-    </form>
-    <form action="/switch" method="POST">
-    <label class="tb">D5, GPIO12</label>
-    <input type="hidden" name="switch/D5" id="D5" value="toggle">
-    <input type="submit" class="tb" [value]="switch/D5">
-    </form>            
-    <form action="/switch" method="POST">
-    <label class="tb">D6, GPIO12</label>
-    <input type="hidden" name="switch/D6" id="D6" value="toggle">
-    <input type="submit" class="tb" [value]="switch/D6">
-    </form>
-    <form action="/switch" method="POST">
-    <label class="tb">D7, GPIO13</label>
-    <input type="hidden" name="switch/D7" id="D7" value="toggle">
-    <input type="submit" class="tb" [value]="switch/D7">
-    </form>
-    )htmlform";
-
 
 Switch::Switch() {
     pinMode(D4, OUTPUT); 
@@ -43,15 +19,16 @@ Switch::Switch() {
     pinMode(D7, OUTPUT); 
 }
 
-void Switch::togglePin(uint8_t pin, String name, const jsonObject_t& config) {
-    if (!config.count(name) == 1) {
+void Switch::togglePin(uint8_t pin, String name, const Properties& config) {
+    if (!config.has(name.c_str())) {
         return;
     }
     uint8_t pinState = digitalRead(pin);
-    bool toggleCommand = config.at(name) == "toggle";
+    PropertyValue command = config.get(name.c_str());
+    bool toggleCommand = command == "toggle";
     bool changeState = 
-        (config.at(name) == "off" && pinState == HIGH) ||
-        (config.at(name) == "on" && pinState == LOW);
+        (command == "off" && pinState == HIGH) ||
+        (command == "on" && pinState == LOW);
 
     if (toggleCommand || changeState) {
         uint8_t newValue = pinState == LOW ? HIGH : LOW;
@@ -63,7 +40,7 @@ void Switch::togglePin(uint8_t pin, String name, const jsonObject_t& config) {
     } 
 }
 
-void Switch::setConfig(jsonObject_t& config) {
+void Switch::setConfig(const Properties& config) {
     togglePin(D4, "switch/D4", config);
     togglePin(D5, "switch/D5", config);
     togglePin(D6, "switch/D6", config);
@@ -73,12 +50,25 @@ void Switch::setConfig(jsonObject_t& config) {
     togglePin(D10, "switch/D10", config);
 }
 
-jsonObject_t Switch::getConfig() {
-    jsonObject_t result;
-    result["switch/D4"] = digitalRead(D4) == HIGH ? "on" : "off";
-    result["switch/D5"] = digitalRead(D5) == HIGH ? "on" : "off";
-    result["switch/D6"] = digitalRead(D6) == HIGH ? "on" : "off";
-    result["switch/D7"] = digitalRead(D7) == HIGH ? "on" : "off";
+bool Switch::isConfigChanged(const Properties& config) {
+    static const char* names[] = { 
+        "switch/D4", "switch/D5", "switch/D6", "switch/D7", "switch/D8", "switch/D9", "switch/D10" 
+    };
+    static const uint8_t pins[] = { D4, D5, D6, D7, D8, D9, D10 };
+    for (uint8_t i = 0; i < sizeof(pins); i++) {
+        if (config.has(names[i]) && config.get(names[i]) != (digitalRead(pins[i]) == HIGH ? "on" : "off")) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Properties Switch::getConfig() {
+    Properties result;
+    result.set(StaticKey("switch/D4"), digitalRead(D4) == HIGH ? "on" : "off");
+    result.set(StaticKey("switch/D5"), digitalRead(D5) == HIGH ? "on" : "off");
+    result.set(StaticKey("switch/D6"), digitalRead(D6) == HIGH ? "on" : "off");
+    result.set(StaticKey("switch/D7"), digitalRead(D7) == HIGH ? "on" : "off");
     return result;
 }
 
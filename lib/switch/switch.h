@@ -12,8 +12,9 @@
 
 #include <Arduino.h>
 #include <message.h>
-#include <map>
+#include <properties.h>
 #include <idevice.h>
+#include <assets.h>
 
 class Switch : public IDevice
 {
@@ -24,13 +25,19 @@ public:
     /**
      * Gets the configuration as key/value map
      */
-    virtual jsonObject_t getConfig();
+    virtual Properties getConfig();
 
     /**
      * Sets the configuration from a key/value map
      * @param config configuration settings in a map
      */
-    virtual void setConfig(jsonObject_t& config);
+    virtual void setConfig(const Properties& config);
+
+    /**
+     * Checks, if the configuration contains a command for a digital output
+     * @param config configuration settings in a map
+     */
+    virtual bool isConfigChanged(const Properties& config);
 
     /**
      * Gets messages to send
@@ -44,8 +51,7 @@ public:
     /**
      * Gets an info about the matching html page
      */
-    virtual HtmlPageInfo getHtmlPage() { return HtmlPageInfo(htmlForm, "/switch", "Switch"); }
-
+    virtual HtmlPageInfo getHtmlPage() { return HtmlPageInfo(switchForm, "/switch", "Switch"); }
 
 private:
 
@@ -55,7 +61,5 @@ private:
      * @param name string representation of the pin number
      * @param config new digital output settings
      */
-    void togglePin(uint8_t pin, String name, const jsonObject_t& config);
-
-    static const char* htmlForm;
+    void togglePin(uint8_t pin, String name, const Properties& config);
 };
\ No newline at end of file
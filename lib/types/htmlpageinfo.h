@@ -13,12 +13,17 @@
 #include <Arduino.h>
 
 struct HtmlPageInfo {
-    HtmlPageInfo() : hasForm(false) {}
-    HtmlPageInfo(String form, String uri, String menuName) 
+    HtmlPageInfo() : hasForm(false), _form(0) {}
+    /**
+     * @param form html form in PROGMEM, must stay valid as long as the page is served
+     * @param uri link to access the form
+     * @param menuName name of the form in the menu
+     */
+    HtmlPageInfo(PGM_P form, String uri, String menuName) 
         : hasForm(true), _form(form), _uri(uri), _menuName(menuName) 
     {}
     bool hasForm;
-    String _form;
+    PGM_P _form;
     String _uri;
     String _menuName;
 };
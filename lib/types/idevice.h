@@ -13,6 +13,7 @@
 #include <imessagebroker.h>
 #include <htmlpageinfo.h>
 #include <message.h>
+#include <properties.h>
 
 class IDevice {
 public:
@@ -21,13 +22,30 @@ public:
      * Sets configuration from a key/value map
      * @param config map containing the configuration
      */
-    virtual void setConfig(jsonObject_t& config) {};
+    virtual void setConfig(const Properties& config) {};
+
+    /**
+     * Checks, if a new configuration changes any setting of the device. The default 
+     * implementation compares the values of all keys returned by getConfig.
+     * @param config map containing the configuration
+     * @returns true, if setConfig must be called
+     */
+    virtual bool isConfigChanged(const Properties& config) {
+        Properties current = getConfig();
+        for (uint16_t i = 0; i < current.size(); i++) {
+            const char* key = current.getKey(i);
+            if (config.has(key) && config.get(key) != current.getValue(i)) {
+                return true;
+            }
+        }
+        return false;
+    }
     
     /**
      * Gets configuration as key/value map
      * @returns configuration 
      */
-    virtual jsonObject_t getConfig() { return jsonObject_t(); };
+    virtual Properties getConfig() { return Properties(); };
 
     /**
      * Writes the configuration to EEPROM
@@ -77,6 +95,35 @@ public:
      */
     virtual void run() {}
 
+    /**
+     * Gets the time between two calls of run, if the device is not sleeping between the cycles
+     * @returns interval in milliseconds, 0 to run once per cycle
+     */
+    virtual uint32_t getRunInterval() { return 0; }
+
+    /**
+     * Gets the time between two publishes of the messages, if the device is not sleeping 
+     * between the cycles
+     * @returns interval in milliseconds, 0 to publish once per cycle
+     */
+    virtual uint32_t getPublishInterval() { return 0; }
+
+    /**
+     * Checks for events to publish without waiting for the next publish interval
+     * @returns true, if getMessages should be published now
+     */
+    virtual bool hasPendingMessages() { return false; }
+
+    /**
+     * Called right before the station enters light sleep, e.g. to enable a wake up pin
+     */
+    virtual void beforeLightSleep() {}
+
+    /**
+     * Called after the station woke up from light sleep
+     */
+    virtual void afterLightSleep() {}
+
     /**
      * Gets an info about the matching html page
      */
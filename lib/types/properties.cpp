@@ -0,0 +1,128 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ */
+
+#define __DEBUG
+#include "debug.h"
+#include "properties.h"
+
+Properties& Properties::operator=(const Properties& properties) {
+    if (this != &properties) {
+        _entries.clear();
+        _arena.clear();
+        _ownedKeys.clear();
+        _garbage = 0;
+        set(properties);
+    }
+    return *this;
+}
+
+int16_t Properties::find(const char* key, uint16_t length) const {
+    int16_t low = 0;
+    int16_t high = int16_t(_entries.size()) - 1;
+    while (low <= high) {
+        int16_t middle = (low + high) / 2;
+        const char* entryKey = _entries[middle].key;
+        int compare = strncmp(entryKey, key, length);
+        if (compare == 0 && entryKey[length] != 0) {
+            // The entry key is longer and thus sorted behind the key
+            compare = 1;
+        }
+        if (compare == 0) {
+            return middle;
+        }
+        if (compare < 0) {
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return -(low + 1);
+}
+
+PropertyValue Properties::get(const char* key, uint16_t length) const {
+    int16_t index = find(key, length);
+    return index < 0 ? PropertyValue("") : getValue(index);
+}
+
+uint16_t Properties::store(const char* value, uint16_t length) {
+    uint16_t offset = _arena.size();
+    _arena.insert(_arena.end(), value, value + length + 1);
+    return offset;
+}
+
+void Properties::insert(int16_t position, const char* key, bool isOwnedKey, const char* value) {
+    uint16_t length = strlen(value);
+    Entry entry = { key, store(value, length), length, isOwnedKey };
+    _entries.insert(_entries.begin() + (-position - 1), entry);
+    _revision++;
+}
+
+bool Properties::setValue(Entry& entry, const char* value) {
+    if (strcmp(&_arena[entry.value], value) == 0) {
+        return false;
+    }
+    uint16_t length = strlen(value);
+    if (length <= entry.capacity) {
+        memcpy(&_arena[entry.value], value, length + 1);
+    } else {
+        _garbage += entry.capacity + 1;
+        entry.value = store(value, length);
+        entry.capacity = length;
+        if (_garbage > _arena.size() / 2) {
+            compact();
+        }
+    }
+    _revision++;
+    return true;
+}
+
+bool Properties::set(StaticKey key, const char* value) {
+    int16_t index = find(key.c_str(), strlen(key.c_str()));
+    if (index >= 0) {
+        return setValue(_entries[index], value);
+    }
+    insert(index, key.c_str(), false, value);
+    return true;
+}
+
+bool Properties::set(const char* key, const char* value) {
+    int16_t index = find(key, strlen(key));
+    if (index >= 0) {
+        return setValue(_entries[index], value);
+    }
+    _ownedKeys.push_front(String(key));
+    insert(index, _ownedKeys.front().c_str(), true, value);
+    return true;
+}
+
+void Properties::set(const Properties& properties) {
+    for (auto const& entry: properties._entries) {
+        const char* value = &properties._arena[entry.value];
+        if (entry.isOwnedKey) {
+            set(entry.key, value);
+        } else {
+            set(StaticKey(entry.key), value);
+        }
+    }
+}
+
+void Properties::compact() {
+    std::vector<char> arena;
+    arena.reserve(_arena.size() - _garbage);
+    for (auto& entry: _entries) {
+        const char* value = &_arena[entry.value];
+        uint16_t length = strlen(value);
+        uint16_t offset = arena.size();
+        arena.insert(arena.end(), value, value + length + 1);
+        entry.value = offset;
+        entry.capacity = length;
+    }
+    _arena.swap(arena);
+    _garbage = 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Provides a compact key/value store for configuration and status values
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include <forward_list>
+
+/**
+ * Read only view of a value stored in Properties. The view is valid until the properties are
+ * changed.
+ */
+class PropertyValue {
+public:
+    PropertyValue(const char* value) : _value(value) {}
+
+    const char* c_str() const { return _value; }
+    operator const char*() const { return _value; }
+    bool isEmpty() const { return *_value == 0; }
+    long toInt() const { return atol(_value); }
+    float toFloat() const { return atof(_value); }
+
+    bool operator==(const char* value) const { return strcmp(_value, value) == 0; }
+    bool operator!=(const char* value) const { return strcmp(_value, value) != 0; }
+
+private:
+    const char* _value;
+};
+
+/**
+ * Key in static memory, e.g. a string literal. Properties reference it without a copy.
+ */
+class StaticKey {
+public:
+    explicit StaticKey(const char* key) : _key(key) {}
+    const char* c_str() const { return _key; }
+
+private:
+    const char* _key;
+};
+
+/**
+ * Key/value store kept in a flat array sorted by key. Keys passed as StaticKey are referenced,
+ * all other keys are copied once on first use.
+ * All values are stored zero terminated in one arena, changed values that do not fit their
+ * slot are appended and the arena is compacted, once half of it is unused.
+ * Lookups never insert.
+ */
+class Properties {
+public:
+    Properties() : _garbage(0), _revision(0) {}
+    Properties(const Properties& properties) : _garbage(0), _revision(0) { set(properties); }
+    Properties(Properties&& properties) = default;
+    Properties& operator=(const Properties& properties);
+    Properties& operator=(Properties&& properties) = default;
+
+    /**
+     * Gets a value
+     * @param key key of the value
+     * @returns value or an empty string, if the key is not found
+     */
+    PropertyValue get(const char* key) const { return get(key, strlen(key)); }
+
+    /**
+     * Gets a value for a key that is not zero terminated
+     * @param key start of the key
+     * @param length length of the key
+     * @returns value or an empty string, if the key is not found
+     */
+    PropertyValue get(const char* key, uint16_t length) const;
+
+    /**
+     * @returns true, if a value is stored for the key
+     */
+    bool has(const char* key) const { return find(key, strlen(key)) >= 0; }
+
+    /**
+     * Sets a value without copying the key
+     * @param key key of the value, must stay valid as long as the properties
+     * @param value value to store
+     * @returns true, if the value changed
+     */
+    bool set(StaticKey key, const char* value);
+    bool set(StaticKey key, const String& value) { return set(key, value.c_str()); }
+
+    /**
+     * Sets a value, copies the key, if it is not yet known
+     * @param key key of the value
+     * @param value value to store
+     * @returns true, if the value changed
+     */
+    bool set(const char* key, const char* value);
+    bool set(const char* key, const String& value) { return set(key, value.c_str()); }
+    bool set(const String& key, const char* value) { return set(key.c_str(), value); }
+    bool set(const String& key, const String& value) { return set(key.c_str(), value.c_str()); }
+
+    /**
+     * Sets all values of other properties
+     * @param properties properties to copy
+     */
+    void set(const Properties& properties);
+
+    /**
+     * Access by position in key order
+     */
+    uint16_t size() const { return _entries.size(); }
+    const char* getKey(uint16_t index) const { return _entries[index].key; }
+    PropertyValue getValue(uint16_t index) const { return PropertyValue(&_arena[_entries[index].value]); }
+
+    /**
+     * @returns a counter increased on every changed value
+     */
+    uint32_t getRevision() const { return _revision; }
+
+private:
+    struct Entry {
+        const char* key;
+        uint16_t value;
+        uint16_t capacity;
+        bool isOwnedKey;
+    };
+
+    /**
+     * Binary search for a key
+     * @param key start of the key
+     * @param length length of the key
+     * @returns index of the entry or -(insert position + 1), if not found
+     */
+    int16_t find(const char* key, uint16_t length) const;
+
+    /**
+     * Inserts a new entry at a position returned by find
+     */
+    void insert(int16_t position, const char* key, bool isOwnedKey, const char* value);
+
+    /**
+     * Sets the value of an existing entry
+     */
+    bool setValue(Entry& entry, const char* value);
+
+    /**
+     * Appends a value to the arena
+     * @returns offset of the value
+     */
+    uint16_t store(const char* value, uint16_t length);
+
+    /**
+     * Removes unused space from the arena
+     */
+    void compact();
+
+    std::vector<Entry> _entries;
+    std::vector<char> _arena;
+    std::forward_list<String> _ownedKeys;
+    uint16_t _garbage;
+    uint32_t _revision;
+};
@@ -0,0 +1,45 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Provides a hash function for content stored in flash
+ */
+#pragma once
+
+#include <Arduino.h>
+
+static const uint32_t FNV_OFFSET_BASIS = 2166136261UL;
+static const uint32_t FNV_PRIME = 16777619UL;
+
+/**
+ * Calculates a 32 bit FNV-1a hash of data stored in PROGMEM
+ * @param data start of the data in PROGMEM
+ * @param length amount of bytes
+ * @param hash hash of the preceding data to continue with
+ */
+inline uint32_t hashP(PGM_P data, size_t length, uint32_t hash = FNV_OFFSET_BASIS) {
+    for (size_t i = 0; i < length; i++) {
+        hash ^= pgm_read_byte(data + i);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * Calculates a 32 bit FNV-1a hash of data stored in RAM
+ * @param data start of the data
+ * @param length amount of bytes
+ * @param hash hash of the preceding data to continue with
+ */
+inline uint32_t hashBytes(const void* data, size_t length, uint32_t hash = FNV_OFFSET_BASIS) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
@@ -19,34 +19,17 @@
 #include "message.h"
 
 
-const char* SoftAP::htmlForm = 
-R"htmlap(
-<form action="/" method="POST">
-<label for="ssid">Access Point name (ssid)</label>
-<input type="text" id="ssid" name="ap/ssid" placeholder="ssid..." [value]="ap/ssid">
-<label for="passwd">Access Point Password</label>
-<input type="password" id="passwd" name="ap/password" placeholder="password...">
-<label for="ip">Access Point IP</label>
-<input type="text" id="ip" name="ap/ip" placeholder="ip..." [value]="ap/ip">
-<label for="gateway">Gateway</label>
-<input type="text" id="gateway" name="ap/gateway" placeholder="gateway" [value]="ap/gateway">
-<label for="subnet">Subnet mask</label>
-<input type="text" id="subnet" name="ap/subnet" placeholder="gateway" [value]="ap/subnet">
-<input type="submit" value="Submit">
-</form>
-)htmlap";
-
 /**
  * Gets the configuration as key/value map
  */
-std::map<String, String> SoftAP::Configuration::get()
+Properties SoftAP::Configuration::get()
 {
-    std::map<String, String> result;
-    result["ap/ssid"] = ssid;
-    result["ap/password"] = password;
-    result["ap/ip"] = ip;
-    result["ap/gateway"] = gateway;
-    result["ap/subnet"] = subnet;
+    Properties result;
+    result.set(StaticKey("ap/ssid"), ssid);
+    result.set(StaticKey("ap/password"), password);
+    result.set(StaticKey("ap/ip"), ip);
+    result.set(StaticKey("ap/gateway"), gateway);
+    result.set(StaticKey("ap/subnet"), subnet);
     return result;
 }
 
@@ -54,19 +37,19 @@ std::map<String, String> SoftAP::Configuration::get()
  * Sets the configuration from a key/value map
  * @param config configuration settings in a map
  */
-void SoftAP::Configuration::set(std::map<String, String> config)
+void SoftAP::Configuration::set(const Properties& config)
 {
-    if (config["ap/ssid"] != "") {
-        ssid = config["ap/ssid"];
+    if (config.get("ap/ssid") != "") {
+        ssid = config.get("ap/ssid");
     }
-    if (config["ap/password"] != "") {
-        password = config["ap/password"];
+    if (config.get("ap/password") != "") {
+        password = config.get("ap/password");
     }
-    if (config["ap/ip"] != "") {
-        ip = config["ap/ip"];
+    if (config.get("ap/ip") != "") {
+        ip = config.get("ap/ip");
     }
-    gateway = config["ap/gateway"];
-    subnet = config["ap/subnet"];
+    gateway = config.get("ap/gateway");
+    subnet = config.get("ap/subnet");
 }
 
 uint16_t SoftAP::writeConfigToEEPROM(uint16_t EEPROMAddress) {
@@ -10,8 +10,9 @@
  */
 #pragma once
 #include <Arduino.h>
-#include <map>
+#include <properties.h>
 #include "idevice.h"
+#include <assets.h>
 #include "staticstring.h"
 
 class SoftAP : public IDevice {
@@ -35,26 +36,26 @@ public:
         /**
          * Gets the configuration as key/value map
          */
-        std::map<String, String> get();
+        Properties get();
 
         /**
          * Sets the configuration from a key/value map
          * @param config configuration settings in a map
          */
-        void set(std::map<String, String> config);
+        void set(const Properties& config);
     };
 
     /**
      * Sets the configuration
      */
-    virtual void setConfig(jsonObject_t& config) { 
+    virtual void setConfig(const Properties& config) { 
         _config.set(config); 
     }
 
     /**
      * Gets the battery configuraiton
      */
-    virtual jsonObject_t getConfig() { 
+    virtual Properties getConfig() { 
         return _config.get();
     }
 
@@ -85,7 +86,7 @@ public:
     /**
      * Gets an info about the matching html page
      */
-    HtmlPageInfo getHtmlPage() { return HtmlPageInfo(htmlForm, "/", "Access Point"); }
+    HtmlPageInfo getHtmlPage() { return HtmlPageInfo(softapForm, "/", "Access Point"); }
 
     /**
      * Checks if the WLAN AP is active
@@ -107,15 +108,9 @@ public:
      */
     static String getLocalIP();
 
-    /**
-     * Form to enter/change wlan settings
-     */
-    static const char* htmlForm;
-
 private:
 
 
     Configuration _config;
-
 };
 
@@ -13,27 +13,18 @@
 #include <ESP8266HTTPClient.h>
 #include <ESP8266WiFi.h>
 #include <eepromaccess.h>
+#include <rtcmem.h>
+#include <hash.h>
 #include "wlan.h"
 
-const char* WLAN::htmlForm = 
-R"htmlwlan(
-<form action="/" method="POST">
-<label for="ssid">Wlan name</label>
-<input type="text" id="ssid" name="wlan/ssid" placeholder="ssid..." [value]="wlan/ssid">
-<label for="passwd">Wlan Password</label>
-<input type="password" id="passwd" name="wlan/password" placeholder="password...">
-<input type="submit" value="Submit">
-</form>
-)htmlwlan";
-
 /**
  * Gets the configuration as key/value map
  */
-std::map<String, String> WLAN::Configuration::get()
+Properties WLAN::Configuration::get()
 {
-    std::map<String, String> result;
-    result["wlan/ssid"] = ssid;
-    result["wlan/password"] = password;
+    Properties result;
+    result.set(StaticKey("wlan/ssid"), ssid);
+    result.set(StaticKey("wlan/password"), password);
     return result;
 }
 
@@ -41,14 +32,15 @@ std::map<String, String> WLAN::Configuration::get()
  * Sets the configuration from a key/value map
  * @param config configuration settings in a map
  */
-void WLAN::Configuration::set(std::map<String, String> config)
+void WLAN::Configuration::set(const Properties& config)
 {
-    ssid = config["wlan/ssid"];
-    password = config["wlan/password"];
-    uuid = getUUID();
+    ssid = config.get("wlan/ssid");
+    password = config.get("wlan/password");
 }
 
 uint16_t WLAN::writeConfigToEEPROM(uint16_t EEPROMAddress) {
+    // The marker validates the configuration of all devices, it is written with any change
+    _config.initUUDI();
     EEPROMAccess::write(EEPROMAddress, (uint8_t*) &_config, sizeof(_config));
     return EEPROMAddress + sizeof(_config);
 }
@@ -75,12 +67,8 @@ void WLAN::reconnect() {
 }
 
  bool WLAN::connect(const String& softAPssid) {
-     bool result = connect();
-     if (!result) {
-         softAP(softAPssid);
-         delay(2000);
-     }
-     return result;
+    beginConnect();
+    return finishConnect(softAPssid);
 }
 
 void WLAN::disconnect() {
@@ -88,6 +76,22 @@ void WLAN::disconnect() {
     delay(50);
 }
 
+RFMode WLAN::getWakeRFMode(bool isTransmitting) {
+    if (!isTransmitting) {
+        return WAKE_RF_DISABLED;
+    }
+    uint32_t wakesSinceCalibration = RTCMem<uint32_t>::read(RTC_RADIO_BLOCK);
+    bool isCalibrationDue = wakesSinceCalibration >= RF_CALIBRATION_INTERVAL || _state == FAILED;
+    RTCMem<uint32_t>::write(RTC_RADIO_BLOCK, isCalibrationDue ? 0 : wakesSinceCalibration + 1);
+    return isCalibrationDue ? WAKE_RFCAL : WAKE_NO_RFCAL;
+}
+
+bool WLAN::enableLightSleep() {
+    bool result = WiFi.setSleepMode(WIFI_LIGHT_SLEEP);
+    PRINTLN_VARIABLE_IF_DEBUG(result)
+    return result;
+}
+
 void WLAN::setAPAndStationMode() {
     WiFi.mode(WIFI_AP_STA);
     PRINTLN_IF_DEBUG("WiFi mode set to WIFI_AP_STA")
@@ -125,26 +129,140 @@ String WLAN::getAPIP() {
     return ip.toString();
 }
 
-bool WLAN::connect() {
-    uint8_t tries = 0;
-    bool isConnectedToWLAN = false;
-    // WiFi.forceSleepWake();
-    delay(1);
+uint32_t WLAN::getConfigHash() {
+    uint32_t hash = hashBytes(_config.ssid.getBuffer(), strlen(_config.ssid.getBuffer()));
+    return hashBytes(_config.password.getBuffer(), strlen(_config.password.getBuffer()), hash);
+}
+
+void WLAN::storeConnection(uint8_t fastConnectAmount) {
+    RTCConnection connection;
+    connection.configHash = getConfigHash();
+    connection.ip = WiFi.localIP();
+    connection.gateway = WiFi.gatewayIP();
+    connection.mask = WiFi.subnetMask();
+    connection.dns = WiFi.dnsIP();
+    memcpy(connection.bssid, WiFi.BSSID(), sizeof(connection.bssid));
+    connection.channel = WiFi.channel();
+    connection.fastConnectAmount = fastConnectAmount;
+    RTCMem<RTCConnection>::write(RTC_WLAN_BLOCK, connection);
+}
+
+void WLAN::registerEventHandlers() {
+    if (_gotIPHandler) {
+        return;
+    }
+    _gotIPHandler = WiFi.onStationModeGotIP([this](const WiFiEventStationModeGotIP&) {
+        _hasGotIP = true;
+    });
+    _disconnectedHandler = WiFi.onStationModeDisconnected([this](const WiFiEventStationModeDisconnected&) {
+        _isDisconnected = true;
+    });
+}
+
+void WLAN::setState(State state) {
+    _state = state;
+    _stateStart = millis();
+    _hasGotIP = false;
+    _isDisconnected = false;
+}
+
+bool WLAN::beginFastConnect() {
+    RTCConnection connection = RTCMem<RTCConnection>::read(RTC_WLAN_BLOCK);
+    if (connection.configHash != getConfigHash() || connection.fastConnectAmount >= MAX_FAST_CONNECTS) {
+        return false;
+    }
+    PRINTLN_IF_DEBUG("Fast connect to the last access point")
+    _fastConnectAmount = connection.fastConnectAmount;
+    setState(FAST_CONNECTING);
+    WiFi.config(IPAddress(connection.ip), IPAddress(connection.gateway), IPAddress(connection.mask), 
+        IPAddress(connection.dns));
+    WiFi.begin(_config.ssid.getBuffer(), _config.password.getBuffer(), connection.channel, connection.bssid);
+    return true;
+}
+
+void WLAN::beginFullConnect() {
+    setState(CONNECTING);
+    WiFi.begin(_config.ssid, _config.password);
+}
+
+void WLAN::beginConnect() {
+    _connectStart = millis();
     WiFi.persistent(false);
+    registerEventHandlers();
     PRINT_IF_DEBUG("Connect to WLAN, ssid: ")
     PRINT_IF_DEBUG(_config.ssid);
     PRINT_IF_DEBUG(" password: ")
     PRINTLN_IF_DEBUG(_config.password);
-    WiFi.begin(_config.ssid, _config.password);
-    while (tries < MAX_TRIES && WiFi.status() != WL_CONNECTED) {
-        delay(200);
-        PRINT_IF_DEBUG(".");
-        tries++;
+    _isFastConnect = beginFastConnect();
+    if (!_isFastConnect) {
+        beginFullConnect();
     }
-    PRINTLN_IF_DEBUG()
+}
+
+WLAN::State WLAN::process() {
+    uint32_t stateTime = millis() - _stateStart;
+    switch (_state) {
+        case FAST_CONNECTING:
+            if (_hasGotIP) {
+                storeConnection(_fastConnectAmount + 1);
+                setState(CONNECTED);
+                printConnectResult();
+            } else if (_isDisconnected || stateTime >= FAST_CONNECT_TIMEOUT) {
+                // The access point moved to another channel or the lease is no longer valid
+                PRINTLN_IF_DEBUG("Fast connect failed, scanning for access points")
+                RTCConnection connection = RTCMem<RTCConnection>::read(RTC_WLAN_BLOCK);
+                connection.configHash = 0;
+                RTCMem<RTCConnection>::write(RTC_WLAN_BLOCK, connection);
+                _isFastConnect = false;
+                WiFi.disconnect();
+                // Back to DHCP
+                WiFi.config(IPAddress(), IPAddress(), IPAddress());
+                beginFullConnect();
+            }
+            break;
+        case CONNECTING:
+            // Disconnect events are expected while the stack retries, only the timeout ends the attempt
+            if (_hasGotIP) {
+                storeConnection(0);
+                setState(CONNECTED);
+                printConnectResult();
+            } else if (stateTime >= CONNECT_TIMEOUT) {
+                setState(FAILED);
+                printConnectResult();
+            }
+            break;
+        default:
+            break;
+    }
+    return _state;
+}
+
+bool WLAN::waitForConnection() {
+    while (process() == FAST_CONNECTING || _state == CONNECTING) {
+        delay(1);
+    }
+    return _state == CONNECTED;
+}
+
+bool WLAN::connect() {
+    beginConnect();
+    return waitForConnection();
+}
+
+bool WLAN::finishConnect(const String& softAPssid) {
+    bool result = waitForConnection();
+    if (!result) {
+        softAP(softAPssid);
+        delay(2000);
+    }
+    return result;
+}
+
+void WLAN::printConnectResult() {
+    _connectTime = millis() - _connectStart;
+    PRINTLN_VARIABLE_IF_DEBUG(_connectTime)
     switch (WiFi.status()) {
         case WL_CONNECTED:
-            isConnectedToWLAN = true;
             PRINT_IF_DEBUG("Connected with IP : ");
             PRINTLN_IF_DEBUG(WiFi.localIP());
             break;
@@ -165,8 +283,15 @@ bool WLAN::connect() {
             PRINTLN_IF_DEBUG("Undefined error code");
             break;
     }  
-    return isConnectedToWLAN;
-    
+}
+
+Messages_t WLAN::getMessages(const String& baseTopic) {
+    Messages_t result;
+    if (_connectTime > 0) {
+        result.push_back(Message(baseTopic + "/wlan/connectTime", String(_connectTime), "send by yaha ESP8266 module"));
+        result.push_back(Message(baseTopic + "/wlan/connectMode", _isFastConnect ? "fast" : "full", "send by yaha ESP8266 module"));
+    }
+    return result;
 }
 
 String WLAN::getLocalIP() {
@@ -10,10 +10,12 @@
  */
 #pragma once
 #include <Arduino.h>
-#include <map>
+#include <ESP8266WiFi.h>
+#include <properties.h>
 #include <debug.h>
 #include <message.h>
 #include <idevice.h>
+#include <assets.h>
 #include "staticstring.h"
 
 
@@ -21,6 +23,11 @@
 class WLAN : public IDevice {
 public:
 
+    /**
+     * States of the connect state machine
+     */
+    enum State { IDLE, FAST_CONNECTING, CONNECTING, CONNECTED, FAILED };
+
     struct Configuration {
         String getUUID() const { return "11896e60-6f3a-46ef-b718-839df2380de5"; }
         void initUUDI() { uuid = getUUID(); }
@@ -33,31 +40,32 @@ public:
         /**
          * Gets the configuration as key/value map
          */
-        std::map<String, String> get();
+        Properties get();
 
         /**
          * Sets the configuration from a key/value map
          * @param config configuration settings in a map
          */
-        void set(std::map<String, String> config);
+        void set(const Properties& config);
     };
 
     /**
      * Constructor
      */
-    WLAN() : _hasAP(false) {}
+    WLAN() : _hasAP(false), _isFastConnect(false), _connectTime(0), _state(IDLE), _stateStart(0), 
+        _connectStart(0), _fastConnectAmount(0), _hasGotIP(false), _isDisconnected(false) {}
 
     /**
      * Sets the configuration
      */
-    virtual void setConfig(jsonObject_t& config) { 
+    virtual void setConfig(const Properties& config) { 
         _config.set(config); 
     }
 
     /**
      * Gets the configuraiton
      */
-    virtual jsonObject_t getConfig() { 
+    virtual Properties getConfig() { 
         return _config.get();
     }
 
@@ -89,7 +97,14 @@ public:
     /**
      * Gets an info about the matching html page
      */
-    HtmlPageInfo getHtmlPage() { return HtmlPageInfo(htmlForm, "/", "WLan"); }
+    HtmlPageInfo getHtmlPage() { return HtmlPageInfo(wlanForm, "/", "WLan"); }
+
+    /**
+     * Gets the duration and the kind (fast/full) of the last connect
+     * @param baseTopic start topic to be used to create the message topic
+     * @returns a list of messages to send with topic, value and reason
+     */
+    virtual Messages_t getMessages(const String& baseTopic);
 
     /**
      * Checks if the WLAN connection is established
@@ -107,6 +122,26 @@ public:
     */
     bool connect(const String& softAPssid);
 
+    /**
+     * Starts to connect without waiting for the connection. Association and DHCP run in the 
+     * background, the progress is tracked by process().
+     */
+    void beginConnect();
+
+    /**
+     * Advances the connect state machine: falls back from a fast to a full connect and detects 
+     * timeouts. Events of the WiFi stack are only evaluated here.
+     * @returns current state
+     */
+    State process();
+
+    /**
+     * Waits for a connect started by beginConnect, creates a station, if it fails
+     * @param softAPssid ssid of a station, if the WLAN connection is not available
+     * @returns true, if connected
+     */
+    bool finishConnect(const String& softAPssid);
+
     /**
      * Sets the mode to simultaneous Access Point and station mode
      */
@@ -142,6 +177,23 @@ public:
      */
     void disconnect();
 
+    /**
+     * Gets the RF mode for the wake after the next deep sleep. Wakes without transmission boot 
+     * with disabled radio. Wakes with transmission skip the RF calibration, except for every 
+     * RF_CALIBRATION_INTERVAL'th wake and after a failed connect.
+     * @param isTransmitting true, if the next wake connects to the WLAN
+     * @returns RF mode to pass to ESP.deepSleep
+     */
+    RFMode getWakeRFMode(bool isTransmitting);
+
+    /**
+     * Lets the SDK put CPU and modem to light sleep in delay(). The station wakes on the beacons 
+     * of the access point, on incoming packets, on the timer of delay and on the GPIO wake pin.
+     * Light sleep is not possible, while the soft AP is active.
+     * @returns true, if the sleep mode is set
+     */
+    bool enableLightSleep();
+
     /**
      * @returns ip address of the access point
      */
@@ -152,14 +204,34 @@ public:
      */
     static String getLocalIP();
 
+private:
+    static const uint32_t CONNECT_TIMEOUT = 10000;
+    static const uint32_t FAST_CONNECT_TIMEOUT = 1500;
+
     /**
-     * Form to enter/change wlan settings
+     * Maximal amount of fast connects in a row. A full connect renews the DHCP lease, before it
+     * expires while the station uses the address statically.
      */
-    static const char* htmlForm;
+    static const uint8_t MAX_FAST_CONNECTS = 32;
 
-private:
-    static const uint8_t MAX_TRIES = 10 * 5;
+    /**
+     * Maximal amount of transmitting wakes without RF calibration
+     */
+    static const uint32_t RF_CALIBRATION_INTERVAL = 24;
 
+    /**
+     * Access point and DHCP lease of the last successful connect, kept in RTC memory
+     */
+    struct RTCConnection {
+        uint32_t configHash;
+        uint32_t ip;
+        uint32_t gateway;
+        uint32_t mask;
+        uint32_t dns;
+        uint8_t bssid[6];
+        uint8_t channel;
+        uint8_t fastConnectAmount;
+    };
 
     /**
      * Internal connect function
@@ -167,9 +239,61 @@ private:
      */
     bool connect();
 
+    /**
+     * Registers the WiFi event handlers, the handlers only set flags evaluated by process()
+     */
+    void registerEventHandlers();
+
+    /**
+     * Starts to connect directly to the access point with the address of the last connect
+     * @returns true, if started, false if there is no valid stored connection
+     */
+    bool beginFastConnect();
+
+    /**
+     * Starts a connect with scan and DHCP
+     */
+    void beginFullConnect();
+
+    /**
+     * Enters a new state of the state machine
+     */
+    void setState(State state);
+
+    /**
+     * Records the connect time and prints the status of the WiFi stack
+     */
+    void printConnectResult();
+
+    /**
+     * Stores access point and address of the current connection to RTC memory
+     * @param fastConnectAmount amount of fast connects in a row, including this one
+     */
+    void storeConnection(uint8_t fastConnectAmount);
+
+    /**
+     * Runs the state machine until the connect succeeded or failed
+     * @returns true, if connected
+     */
+    bool waitForConnection();
+
+    /**
+     * @returns hash identifying the configuration the stored connection belongs to
+     */
+    uint32_t getConfigHash();
+
     bool _hasAP;
+    bool _isFastConnect;
+    uint32_t _connectTime;
+    State _state;
+    uint32_t _stateStart;
+    uint32_t _connectStart;
+    uint8_t _fastConnectAmount;
+    volatile bool _hasGotIP;
+    volatile bool _isDisconnected;
+    WiFiEventHandler _gotIPHandler;
+    WiFiEventHandler _disconnectedHandler;
 
     Configuration _config;
-
 };
 
@@ -15,6 +15,8 @@
 
 BrokerProxy YahaServer::brokerProxy;
 WLAN YahaServer::wlan;
+SampleBuffer YahaServer::sampleBuffer;
+PublishFilter YahaServer::publishFilter;
 std::vector<IDevice*> YahaServer::_devices;
 std::vector<uint8_t> YahaServer::_priority;
 
@@ -43,14 +45,40 @@ void YahaServer::setupDevices(uint8_t priority) {
     }
 }
 
-void YahaServer::setup(const String APSSID) {
-    setupEEPROM();
+void YahaServer::beginConnect() {
     setupDevices(1);
     MQTTServer::begin();
-    wlan.connect(APSSID);
+    // Association and DHCP run in the background while the sensors are read in setup
+    wlan.beginConnect();
+}
+
+void YahaServer::setup(const String APSSID) {
+    HeapMonitor::Scope heapScope(HeapMonitor::SETUP);
+    brokerProxy.setDeliveredFunction([](const Message& message) { publishFilter.delivered(message); });
+    Profiler::begin(Profiler::EEPROM_READ);
+    setupEEPROM();
+    Profiler::end(Profiler::EEPROM_READ);
+    bool isSamplingWake = sampleBuffer.isSamplingWake();
+    if (!isSamplingWake) {
+        beginConnect();
+    }
     setupDevices(0);
-    for (auto const& device : _devices) {
-        MQTTServer::addForm(device->getHtmlPage());
+    if (isSamplingWake && !sampleBuffer.isSamplingWake()) {
+        // The radio is disabled on sampling wakes, it is only enabled by a restart
+        PRINTLN_IF_DEBUG("Sensor value changed, restarting with radio")
+        sampleBuffer.store(0, false);
+        ESP.deepSleep(RESTART_WITH_RADIO_TIME, wlan.getWakeRFMode(true));
+    }
+    if (!isSamplingWake) {
+        Profiler::begin(Profiler::WLAN_CONNECT);
+        wlan.finishConnect(APSSID);
+        Profiler::end(Profiler::WLAN_CONNECT);
+        brokerProxy.connect();
+        // The web server is only started with the radio
+        Scheduler::setIdleFunction(serveClients);
+        for (auto const& device : _devices) {
+            MQTTServer::addForm(device->getHtmlPage());
+        }
     }
 
     PRINTLN_VARIABLE_IF_DEBUG(system_get_free_heap_size())
@@ -61,66 +89,159 @@ void YahaServer::closeDown() {
     if (wlan.isConnected()) {
         brokerProxy.publishMessage(_runtime.getMessage(brokerProxy.getBaseTopic()));
     }
+    Profiler::begin(Profiler::DISCONNECT);
     for (auto const& device: _devices) {
         device->closeDown();
     }
+    // Samples are kept until the broker accepted them
+    sampleBuffer.store(_sleepTimeInSeconds, brokerProxy.isFlushed());
+    RFMode rfMode = wlan.getWakeRFMode(!sampleBuffer.isNextSampling());
     if (wlan.isConnected()) {
         wlan.disconnect(); 
     }
+    Profiler::end(Profiler::DISCONNECT);
+    Profiler::endCycle();
     PRINTLN_IF_DEBUG("\nDisconnected from WiFi, going to sleep for " + String(_sleepTimeInSeconds) + " seconds ...")
     IF_DEBUG(delay(100);)
-    ESP.deepSleep(_sleepTimeInSeconds * DEEP_SLEEP_ONE_SECOND); 
+    ESP.deepSleep(std::min(uint64_t(_sleepTimeInSeconds) * DEEP_SLEEP_ONE_SECOND, ESP.deepSleepMax()), rfMode); 
 }
 
-void YahaServer::loop() {
-    if (wlan.isConnected()) {
+void YahaServer::serveClients() {
+    MQTTServer::handleClient();
+    brokerProxy.processQueue();
+    if (MQTTServer::isChanged() && wlan.isConnected()) {
+        brokerProxy.publishMessages(publishFilter.filter(MQTTServer::getMessages(brokerProxy.getBaseTopic())));
+        MQTTServer::setChanged(false);
+    }
+}
+
+void YahaServer::publish(IDevice* device) {
+    if (!wlan.isConnected()) {
+        return;
+    }
+    HeapMonitor::Scope heapScope(HeapMonitor::PUBLISH);
+    Profiler::Scope profilerScope(Profiler::PUBLISH);
+    Messages_t messages;
+    if (device != nullptr) {
+        messages = device->getMessages(brokerProxy.getBaseTopic());
+    } else {
         for(auto const& device: _devices) {
-            brokerProxy.publishMessages(device->getMessages(brokerProxy.getBaseTopic()));
+            Messages_t deviceMessages = device->getMessages(brokerProxy.getBaseTopic());
+            messages.insert(messages.end(), deviceMessages.begin(), deviceMessages.end());
         }
-        PRINT_IF_DEBUG("Waiting for broker to send messages, ... ")
-        for (uint16_t i = 0; i < 50; i++) {
-            MQTTServer::handleClient();
-            delay(10);
+    }
+    MQTTServer::setState(brokerProxy.getBaseTopic(), messages);
+    brokerProxy.publishMessages(publishFilter.filter(messages));
+}
+
+void YahaServer::runDevice(uint8_t index) {
+    Profiler::Scope profilerScope(Profiler::getDeviceSpan(index));
+    _devices[index]->run();
+}
+
+void YahaServer::scheduleDevices() {
+    for (uint8_t i = 0; i < _devices.size(); i++) {
+        IDevice* device = _devices[i];
+        uint32_t publishInterval = device->getPublishInterval();
+        if (publishInterval == 0) {
+            publishInterval = CYCLE_TIME;
         }
-        PRINTLN_IF_DEBUG(" Done")
-        if (MQTTServer::isChanged()) {
-            brokerProxy.publishMessages(MQTTServer::getMessages(brokerProxy.getBaseTopic()));
-            MQTTServer::setChanged(false);
+        Scheduler::addTask([device]() { publish(device); }, publishInterval);
+    }
+    for (uint8_t i = 0; i < _devices.size(); i++) {
+        uint32_t runInterval = _devices[i]->getRunInterval();
+        if (runInterval == 0) {
+            runInterval = CYCLE_TIME;
+        }
+        // First run after the first publish, as in battery mode
+        Scheduler::addTask([i]() { runDevice(i); }, runInterval, PUBLISH_WAIT_TIME);
+    }
+    Scheduler::addTask([]() {
+        for (auto const& device: _devices) {
+            if (device->hasPendingMessages()) {
+                publish(device);
+            }
         }
+    }, Scheduler::getIdleInterval());
+}
+
+void YahaServer::setupLightSleep() {
+    if (!_isLightSleep || !wlan.isConnected()) {
+        return;
+    }
+    if (wlan.hasAP()) {
+        wlan.apDisconnect();
+    }
+    if (wlan.enableLightSleep()) {
+        Scheduler::setIdleInterval(LIGHT_SLEEP_IDLE_INTERVAL);
+        Scheduler::setSleepFunctions(beforeLightSleep, afterLightSleep);
+    }
+}
+
+void YahaServer::beforeLightSleep() {
+    for (auto const& device: _devices) {
+        device->beforeLightSleep();
     }
+}
+
+void YahaServer::afterLightSleep() {
     for (auto const& device: _devices) {
-        device->run();
+        device->afterLightSleep();
     }
+}
+
+void YahaServer::loop() {
     bool noWLANAfterPowerOn = _isPowerOn && !wlan.isConnected();
     PRINTLN_VARIABLE_IF_DEBUG(_isBatteryMode)
     if (!noWLANAfterPowerOn && _isBatteryMode) {
+        if (wlan.isConnected()) {
+            publish();
+            PRINT_IF_DEBUG("Waiting for broker to send messages, ... ")
+            Profiler::begin(Profiler::WAIT);
+            Scheduler::runFor(PUBLISH_WAIT_TIME);
+            Profiler::end(Profiler::WAIT);
+            PRINTLN_IF_DEBUG(" Done")
+        }
+        for (uint8_t i = 0; i < _devices.size(); i++) {
+            runDevice(i);
+        }
         closeDown();
     } else {
-        for (uint16_t i = 0; i < 5000; i++) {
-            MQTTServer::handleClient();
-            delay(10);
+        if (!_isScheduled) {
+            setupLightSleep();
+            scheduleDevices();
+            _isScheduled = true;
         }
+        Scheduler::runFor(CYCLE_TIME);
+        Profiler::endCycle();
     }
 }
 
 
-void YahaServer::setDeviceConfigFromJSON(jsonObject_t& config) {
+void YahaServer::setDeviceConfigFromJSON(const Properties& config) {
     for (auto const& device: _devices) {
         device->setConfig(config);
     }
 }
 
-void YahaServer::updateConfig(jsonObject_t config) {
+void YahaServer::updateConfig(const Properties& config) {
     PRINTLN_IF_DEBUG("update Configuration")
+    HeapMonitor::Scope heapScope(HeapMonitor::CONFIG);
 
     uint16_t EEPROMAddress = EEPROM_START_ADDR;
+    bool isChanged = false;
 
     for (auto const& device: _devices) {
-        device->setConfig(config);
+        if (device->isConfigChanged(config)) {
+            device->setConfig(config);
+            isChanged = true;
+        }
         EEPROMAddress = device->writeConfigToEEPROM(EEPROMAddress);
     }
-    EEPROMAccess::commit();
-    PRINTLN_IF_DEBUG("Configuration committed")
+    if (isChanged) {
+        EEPROMAccess::commit();
+        PRINTLN_IF_DEBUG("Configuration committed")
+    }
 }
 
 void YahaServer::setupEEPROM() {
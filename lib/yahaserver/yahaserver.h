@@ -16,13 +16,19 @@
 #include "idevice.h"
 #include "wlan.h"
 #include "brokerproxy.h"
+#include "publishfilter.h"
 #include "mqttserver.h"
 #include "eepromaccess.h"
 #include "runtime.h"
+#include "heapmonitor.h"
+#include "profiler.h"
+#include "scheduler.h"
+#include "samplebuffer.h"
 
 class YahaServer : public IMessageBroker {
 public:
-    YahaServer() : _isBatteryMode(false), _isPowerOn(false) {
+    YahaServer() : _isBatteryMode(false), _isPowerOn(false), _isScheduled(false), 
+        _isLightSleep(false) {
         MQTTServer::registerOnUpdateFunction(updateConfig);
         addDevice(&wlan);
         addDevice(&brokerProxy);
@@ -44,6 +50,22 @@ public:
      */
     void loop();
 
+    /**
+     * Lets the station sleep between the scheduled tasks, if it does not sleep between the cycles.
+     * The access point is closed, once the WLAN is connected.
+     */
+    void enableLightSleep() { _isLightSleep = true; }
+
+    /**
+     * Connects only on every uploadInterval'th wake in battery mode. The other wakes store the
+     * sensor values in RTC memory, they are uploaded on the next wake with connection.
+     * @param uploadInterval every uploadInterval'th wake connects
+     */
+    void enableSampling(uint8_t uploadInterval) {
+        sampleBuffer.setUploadInterval(uploadInterval);
+        addDevice(&sampleBuffer);
+    }
+
     /**
      * Adds a device
      * @param device pointer to a device object
@@ -56,9 +78,10 @@ public:
     }
 
     /**
-     * Updates the configuration, stores it to eeprom
+     * Updates the configuration of all devices affected by a change and stores it to eeprom
+     * @param config complete configuration shared by all devices
      */
-    static void updateConfig(std::map<String, String> config);
+    static void updateConfig(const Properties& config);
 
     /**
      * Initializes the eeprom, reads the configuration and initializes the objects
@@ -74,23 +97,78 @@ public:
 
     static BrokerProxy brokerProxy;
     static WLAN wlan;
+    static SampleBuffer sampleBuffer;
+    static PublishFilter publishFilter;
 
 private:
 
+    /**
+     * Sets up the devices needed before the connect and starts to connect to the WLAN
+     */
+    void beginConnect();
+
     /**
      * Setup all devices of a priority
      * @param priority of the devices to set up
      */
     void setupDevices(uint8_t priority);
 
-    static void setDeviceConfigFromJSON(jsonObject_t& config);
+    static void setDeviceConfigFromJSON(const Properties& config);
+
+    /**
+     * Serves http requests, sends queued messages and publishes configuration changes
+     */
+    static void serveClients();
+
+    /**
+     * Publishes the messages of a device
+     * @param device device to publish, nullptr publishes the messages of all devices
+     */
+    static void publish(IDevice* device = nullptr);
+
+    /**
+     * Calls the run function of a device
+     * @param index index of the device
+     */
+    static void runDevice(uint8_t index);
+
+    /**
+     * Adds the periodic run and publish tasks of all devices to the scheduler. Used, if the
+     * device does not sleep between the cycles. Devices are checked for events in the idle interval.
+     */
+    static void scheduleDevices();
+
+    /**
+     * Switches to light sleep between the scheduled tasks, if enabled and connected to the WLAN
+     */
+    void setupLightSleep();
+
+    /**
+     * Informs all devices that the station enters light sleep
+     */
+    static void beforeLightSleep();
+
+    /**
+     * Informs all devices that the station woke up from light sleep
+     */
+    static void afterLightSleep();
 
     static const uint16_t EEPROM_START_ADDR = 0;
+    // Default interval of run and publish without sleep
+    static const uint32_t CYCLE_TIME = 50000;
+    // Deep sleep in microseconds to restart a sampling wake with radio
+    static const uint32_t RESTART_WITH_RADIO_TIME = 100000;
+    // Time to send queued messages and to serve http requests after publishing in battery mode
+    static const uint32_t PUBLISH_WAIT_TIME = 500;
+    // Maximal sleep time between two checks for http requests and device events in light sleep
+    static const uint32_t LIGHT_SLEEP_IDLE_INTERVAL = 100;
     static std::vector<IDevice*> _devices;
     static std::vector<uint8_t> _priority;
 
     bool _isBatteryMode;
     bool _isPowerOn;
+    bool _isScheduled;
+    bool _isLightSleep;
     uint16_t _sleepTimeInSeconds;
     Runtime _runtime;
 
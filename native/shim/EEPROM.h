@@ -0,0 +1,30 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Host implementation of the ESP8266 EEPROM emulation
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+class EEPROMClass {
+public:
+    void begin(size_t size);
+    uint8_t read(int address);
+    void write(int address, uint8_t value);
+    bool commit();
+    size_t length() { return _size; }
+    uint32_t getCommitAmount() { return _commitAmount; }
+private:
+    uint8_t _data[4096];
+    size_t _size;
+    uint32_t _commitAmount;
+};
+extern EEPROMClass EEPROM;
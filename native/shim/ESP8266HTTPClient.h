@@ -0,0 +1,51 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Host implementation of the ESP8266 HTTPClient using the loopback broker
+ */
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+#define HTTPC_ERROR_CONNECTION_FAILED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+class HTTPClient {
+public:
+    HTTPClient() : _reuse(true), _timeout(5000) {}
+    bool begin(WiFiClient& client, const String& url) { _client = &client; _url = url; _headers.clear(); return true; }
+    bool begin(WiFiClient& client, const String& host, uint16_t port, const String& uri) {
+        return begin(client, String("http://") + host + ":" + String(port) + uri);
+    }
+    void end() { _headers.clear(); }
+    void setReuse(bool reuse) { _reuse = reuse; }
+    void setTimeout(uint16_t timeout) { _timeout = timeout; }
+    void addHeader(const String& name, const String& value, bool first = false, bool replace = true) {
+        _headers.push_back(std::make_pair(name, value));
+    }
+    int GET() { return sendRequest("GET", ""); }
+    int PUT(const String& payload) { return sendRequest("PUT", payload); }
+    int PUT(const uint8_t* payload, size_t size) { return sendRequest("PUT", String((const char*)payload, size)); }
+    int POST(const String& payload) { return sendRequest("POST", payload); }
+    int sendRequest(const char* type, const String& payload);
+    String getString() { return _response; }
+    bool connected() { return _client != 0 && _client->connected(); }
+private:
+    WiFiClient* _client = 0;
+    String _url;
+    String _response;
+    bool _reuse;
+    uint16_t _timeout;
+    std::vector<std::pair<String, String>> _headers;
+};
@@ -0,0 +1,100 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Host implementation of the ESP8266WebServer. Requests are injected with handleRequest
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+#include <utility>
+#include "Arduino.h"
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t) -1)
+#define CONTENT_LENGTH_NOT_SET ((size_t) -2)
+
+class ESP8266WebServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    ESP8266WebServer(int port = 80) : _contentLength(CONTENT_LENGTH_NOT_SET) {}
+    void begin() {}
+    void handleClient() {}
+    void on(const String& uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+    void on(const String& uri, HTTPMethod method, THandlerFunction handler) {
+        _handlers.push_back(Handler{uri, method, handler});
+    }
+    void onNotFound(THandlerFunction handler) { _notFoundHandler = handler; }
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
+        _collectedHeaders.assign(headerKeys, headerKeys + headerKeysCount);
+    }
+
+    String uri() { return _uri; }
+    HTTPMethod method() { return _method; }
+    String arg(const String& name);
+    String arg(int i) { return i < int(_args.size()) ? _args[i].second : String(); }
+    String argName(int i) { return i < int(_args.size()) ? _args[i].first : String(); }
+    int args() { return _args.size(); }
+    bool hasArg(const String& name);
+    String header(const String& name);
+    String header(int i) { return i < int(_requestHeaders.size()) ? _requestHeaders[i].second : String(); }
+    String headerName(int i) { return i < int(_requestHeaders.size()) ? _requestHeaders[i].first : String(); }
+    int headers() { return _requestHeaders.size(); }
+    bool hasHeader(const String& name);
+
+    void setContentLength(size_t contentLength) { _contentLength = contentLength; }
+    void sendHeader(const String& name, const String& value, bool first = false) {
+        _responseHeaders.push_back(std::make_pair(name, value));
+    }
+    void send(int code, const char* contentType = 0, const String& content = String());
+    void send(int code, const String& contentType, const String& content) { send(code, contentType.c_str(), content); }
+    void send(int code, const char* contentType, const char* content, size_t contentLength);
+    void send_P(int code, PGM_P contentType, PGM_P content) { send(code, contentType, String(content)); }
+    void send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength) { send(code, contentType, content, contentLength); }
+    void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+    void sendContent(const char* content, size_t size);
+    void sendContent_P(PGM_P content) { sendContent(content, strlen(content)); }
+    void sendContent_P(PGM_P content, size_t size) { sendContent(content, size); }
+
+    /**
+     * Host only: processes a request and returns the status code
+     */
+    int handleRequest(HTTPMethod method, const String& uri, const String& body = String(),
+        const std::vector<std::pair<String, String>>& args = {},
+        const std::vector<std::pair<String, String>>& headers = {});
+
+    /**
+     * Host only: response of the last request
+     */
+    const String& responseBody() const { return _responseBody; }
+    const std::vector<std::pair<String, String>>& responseHeaders() const { return _responseHeaders; }
+    size_t responseChunks() const { return _responseChunks; }
+    size_t maxChunkSize() const { return _maxChunkSize; }
+private:
+    struct Handler {
+        String uri;
+        HTTPMethod method;
+        THandlerFunction handler;
+    };
+    std::vector<Handler> _handlers;
+    THandlerFunction _notFoundHandler;
+    std::vector<const char*> _collectedHeaders;
+    String _uri;
+    HTTPMethod _method;
+    std::vector<std::pair<String, String>> _args;
+    std::vector<std::pair<String, String>> _requestHeaders;
+    std::vector<std::pair<String, String>> _responseHeaders;
+    size_t _contentLength;
+    int _responseCode;
+    String _responseBody;
+    size_t _responseChunks;
+    size_t _maxChunkSize;
+};
@@ -0,0 +1,109 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Host implementation of the ESP8266 WiFi interface
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <functional>
+#include <vector>
+#include "Arduino.h"
+#include "IPAddress.h"
+#include "WiFiClient.h"
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_WRONG_PASSWORD = 6,
+    WL_DISCONNECTED = 7
+} wl_status_t;
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } WiFiMode_t;
+typedef enum { WIFI_NONE_SLEEP = 0, WIFI_LIGHT_SLEEP = 1, WIFI_MODEM_SLEEP = 2 } WiFiSleepType_t;
+
+struct WiFiEventStationModeGotIP {
+    IPAddress ip;
+    IPAddress mask;
+    IPAddress gw;
+};
+
+struct WiFiEventStationModeDisconnected {
+    String ssid;
+    uint8_t bssid[6];
+    uint8_t reason;
+};
+
+class WiFiEventHandlerOpaque;
+typedef std::shared_ptr<WiFiEventHandlerOpaque> WiFiEventHandler;
+
+class ESP8266WiFiClass {
+public:
+    ESP8266WiFiClass();
+    wl_status_t begin(const char* ssid, const char* password = 0, int32_t channel = 0, const uint8_t* bssid = 0, bool connect = true);
+    wl_status_t begin(const String& ssid, const String& password = String(), int32_t channel = 0, const uint8_t* bssid = 0, bool connect = true) {
+        return begin(ssid.c_str(), password.c_str(), channel, bssid, connect);
+    }
+    bool config(IPAddress localIP, IPAddress gateway, IPAddress subnet, IPAddress dns1 = IPAddress(), IPAddress dns2 = IPAddress());
+    wl_status_t status();
+    bool disconnect(bool wifiOff = false);
+    bool mode(WiFiMode_t mode) { _mode = mode; return true; }
+    WiFiMode_t getMode() { return _mode; }
+    void persistent(bool) {}
+    bool setAutoReconnect(bool) { return true; }
+    bool setSleepMode(WiFiSleepType_t type, uint8_t listenInterval = 0) { _sleepType = type; return true; }
+    WiFiSleepType_t getSleepMode() { return _sleepType; }
+    bool forceSleepBegin(uint32_t = 0) { _mode = WIFI_OFF; return true; }
+    bool forceSleepWake() { return true; }
+    IPAddress localIP() { return _status == WL_CONNECTED ? _ip : IPAddress(); }
+    IPAddress gatewayIP() { return _gateway; }
+    IPAddress subnetMask() { return _mask; }
+    IPAddress dnsIP(uint8_t = 0) { return _dns; }
+    uint8_t* BSSID() { return _bssid; }
+    int32_t channel() { return _channel; }
+    int32_t RSSI() { return -60; }
+    bool softAPConfig(IPAddress localIP, IPAddress gateway, IPAddress subnet) { _apIP = localIP; return true; }
+    bool softAP(const String& ssid, const String& password = String()) { return true; }
+    IPAddress softAPIP() { return _apIP; }
+    bool softAPdisconnect(bool = false) { return true; }
+
+    WiFiEventHandler onStationModeGotIP(std::function<void(const WiFiEventStationModeGotIP&)> handler);
+    WiFiEventHandler onStationModeDisconnected(std::function<void(const WiFiEventStationModeDisconnected&)> handler);
+
+    /**
+     * Host only: advances the simulated association, called from delay() and yield()
+     */
+    void poll();
+
+    /**
+     * Host only: sets the simulated association times in milliseconds
+     */
+    void setSimulatedConnectTime(uint32_t fullConnect, uint32_t fastConnect) {
+        _fullConnectTime = fullConnect;
+        _fastConnectTime = fastConnect;
+    }
+private:
+    WiFiMode_t _mode;
+    WiFiSleepType_t _sleepType;
+    wl_status_t _status;
+    unsigned long _connectDue;
+    uint32_t _fullConnectTime;
+    uint32_t _fastConnectTime;
+    bool _staticIP;
+    IPAddress _ip, _gateway, _mask, _dns, _apIP;
+    uint8_t _bssid[6];
+    int32_t _channel;
+    std::vector<std::weak_ptr<WiFiEventHandlerOpaque>> _handlers;
+};
+extern ESP8266WiFiClass WiFi;
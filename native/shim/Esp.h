@@ -0,0 +1,42 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Host implementation of the ESP class
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "user_interface.h"
+
+enum RFMode {
+    RF_DEFAULT = 0,
+    RF_CAL = 1,
+    RF_NO_CAL = 2,
+    RF_DISABLED = 4
+};
+
+#define WAKE_RF_DEFAULT RF_DEFAULT
+#define WAKE_RFCAL RF_CAL
+#define WAKE_NO_RFCAL RF_NO_CAL
+#define WAKE_RF_DISABLED RF_DISABLED
+
+class EspClass {
+public:
+    void deepSleep(uint64_t timeUs, RFMode mode = RF_DEFAULT);
+    // The SDK calculates it from the RTC clock calibration, about 3.5 hours
+    uint64_t deepSleepMax() { return 12600000000ULL; }
+    uint32_t getFreeHeap() { return system_get_free_heap_size(); }
+    uint32_t getMaxFreeBlockSize() { return system_get_free_heap_size(); }
+    uint8_t getHeapFragmentation() { return 0; }
+    uint32_t getChipId() { return 0x00C0FFEE; }
+    uint32_t random() { return 0x5EED1234; }
+    struct rst_info* getResetInfoPtr();
+    void restart() {}
+};
+extern EspClass ESP;
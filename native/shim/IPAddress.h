@@ -0,0 +1,45 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Host implementation of the Arduino IPAddress class
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include "WString.h"
+
+class IPAddress {
+public:
+    IPAddress() : _address(0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+        : _address(uint32_t(a) | uint32_t(b) << 8 | uint32_t(c) << 16 | uint32_t(d) << 24) {}
+    IPAddress(uint32_t address) : _address(address) {}
+    bool fromString(const String& address) { return fromString(address.c_str()); }
+    bool fromString(const char* address) {
+        unsigned int a, b, c, d;
+        if (sscanf(address, "%u.%u.%u.%u", &a, &b, &c, &d) != 4 || a > 255 || b > 255 || c > 255 || d > 255) {
+            return false;
+        }
+        *this = IPAddress(a, b, c, d);
+        return true;
+    }
+    String toString() const {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u.%u.%u.%u", 
+            unsigned(_address & 0xFF), unsigned(_address >> 8 & 0xFF), 
+            unsigned(_address >> 16 & 0xFF), unsigned(_address >> 24));
+        return String(buf);
+    }
+    bool isSet() const { return _address != 0; }
+    operator uint32_t() const { return _address; }
+    uint8_t operator[](int index) const { return uint8_t(_address >> (8 * index)); }
+private:
+    uint32_t _address;
+};
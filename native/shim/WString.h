@@ -0,0 +1,146 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Host implementation of the Arduino String class backed by std::string
+ */
+
+#pragma once
+
+#include <string>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include "pgmspace.h"
+
+class String {
+public:
+    String() {}
+    String(const char* str) : _s(str == 0 ? "" : str) {}
+    String(const char* str, size_t length) : _s(str, length) {}
+    String(const __FlashStringHelper* str) : _s(reinterpret_cast<const char*>(str)) {}
+    String(const std::string& str) : _s(str) {}
+    String(char c) : _s(1, c) {}
+    String(unsigned char value, unsigned char base = 10) { fromUnsigned(value, base); }
+    String(int value, unsigned char base = 10) { fromSigned(value, base); }
+    String(unsigned int value, unsigned char base = 10) { fromUnsigned(value, base); }
+    String(long value, unsigned char base = 10) { fromSigned(value, base); }
+    String(unsigned long value, unsigned char base = 10) { fromUnsigned(value, base); }
+    String(float value, unsigned char decimalPlaces = 2) { fromDouble(value, decimalPlaces); }
+    String(double value, unsigned char decimalPlaces = 2) { fromDouble(value, decimalPlaces); }
+
+    unsigned int length() const { return _s.length(); }
+    const char* c_str() const { return _s.c_str(); }
+    bool reserve(unsigned int size) { _s.reserve(size); return true; }
+    char charAt(unsigned int index) const { return index < _s.length() ? _s[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char& operator[](unsigned int index) { return _s[index]; }
+    void setCharAt(unsigned int index, char c) { if (index < _s.length()) _s[index] = c; }
+
+    String& operator=(const char* str) { _s = str == 0 ? "" : str; return *this; }
+    String& operator+=(const String& str) { _s += str._s; return *this; }
+    String& operator+=(const char* str) { _s += str; return *this; }
+    String& operator+=(char c) { _s += c; return *this; }
+    String& operator+=(int value) { return operator+=(String(value)); }
+    String& operator+=(unsigned int value) { return operator+=(String(value)); }
+    String& operator+=(long value) { return operator+=(String(value)); }
+    String& operator+=(unsigned long value) { return operator+=(String(value)); }
+    bool concat(const String& str) { _s += str._s; return true; }
+    bool concat(const char* str) { _s += str; return true; }
+    bool concat(const char* str, unsigned int length) { _s.append(str, length); return true; }
+    bool concat(char c) { _s += c; return true; }
+
+    friend String operator+(const String& lhs, const String& rhs) { return String(lhs._s + rhs._s); }
+    friend String operator+(const String& lhs, const char* rhs) { return String(lhs._s + rhs); }
+    friend String operator+(const char* lhs, const String& rhs) { return String(lhs + rhs._s); }
+    friend String operator+(const String& lhs, char rhs) { return String(lhs._s + rhs); }
+    friend String operator+(const String& lhs, int rhs) { return lhs + String(rhs); }
+    friend String operator+(const String& lhs, unsigned int rhs) { return lhs + String(rhs); }
+    friend String operator+(const String& lhs, long rhs) { return lhs + String(rhs); }
+    friend String operator+(const String& lhs, unsigned long rhs) { return lhs + String(rhs); }
+    friend String operator+(const String& lhs, float rhs) { return lhs + String(rhs); }
+    friend String operator+(const String& lhs, double rhs) { return lhs + String(rhs); }
+
+    bool equals(const String& str) const { return _s == str._s; }
+    bool equals(const char* str) const { return _s == str; }
+    bool operator==(const String& rhs) const { return _s == rhs._s; }
+    bool operator==(const char* rhs) const { return _s == rhs; }
+    bool operator!=(const String& rhs) const { return _s != rhs._s; }
+    bool operator!=(const char* rhs) const { return _s != rhs; }
+    bool operator<(const String& rhs) const { return _s < rhs._s; }
+    friend bool operator==(const char* lhs, const String& rhs) { return rhs._s == lhs; }
+    friend bool operator!=(const char* lhs, const String& rhs) { return rhs._s != lhs; }
+    bool equalsIgnoreCase(const String& str) const {
+        if (str.length() != length()) return false;
+        for (size_t i = 0; i < _s.length(); i++) {
+            if (tolower(_s[i]) != tolower(str._s[i])) return false;
+        }
+        return true;
+    }
+
+    bool startsWith(const String& prefix) const { return _s.compare(0, prefix._s.length(), prefix._s) == 0; }
+    bool endsWith(const String& suffix) const {
+        return _s.length() >= suffix._s.length() &&
+            _s.compare(_s.length() - suffix._s.length(), suffix._s.length(), suffix._s) == 0;
+    }
+    int indexOf(char c, unsigned int from = 0) const { return toIndex(_s.find(c, from)); }
+    int indexOf(const String& str, unsigned int from = 0) const { return toIndex(_s.find(str._s, from)); }
+    int lastIndexOf(char c) const { return toIndex(_s.rfind(c)); }
+    int lastIndexOf(char c, unsigned int from) const { return toIndex(_s.rfind(c, from)); }
+    int lastIndexOf(const String& str) const { return toIndex(_s.rfind(str._s)); }
+    int lastIndexOf(const String& str, unsigned int from) const { return toIndex(_s.rfind(str._s, from)); }
+    String substring(unsigned int from) const { return from < _s.length() ? String(_s.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) std::swap(from, to);
+        if (from >= _s.length()) return String();
+        return String(_s.substr(from, to - from));
+    }
+    void replace(const String& find, const String& replace) {
+        if (find._s.empty()) return;
+        size_t pos = 0;
+        while ((pos = _s.find(find._s, pos)) != std::string::npos) {
+            _s.replace(pos, find._s.length(), replace._s);
+            pos += replace._s.length();
+        }
+    }
+    void remove(unsigned int index) { if (index < _s.length()) _s.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < _s.length()) _s.erase(index, count); }
+    void toLowerCase() { for (auto& c : _s) c = tolower(c); }
+    void toUpperCase() { for (auto& c : _s) c = toupper(c); }
+    void trim() {
+        size_t start = _s.find_first_not_of(" \t\r\n");
+        size_t end = _s.find_last_not_of(" \t\r\n");
+        _s = start == std::string::npos ? "" : _s.substr(start, end - start + 1);
+    }
+    long toInt() const { return atol(_s.c_str()); }
+    float toFloat() const { return atof(_s.c_str()); }
+    double toDouble() const { return atof(_s.c_str()); }
+
+private:
+    static int toIndex(size_t pos) { return pos == std::string::npos ? -1 : int(pos); }
+    void fromSigned(long value, unsigned char base) {
+        if (base == 10) { _s = std::to_string(value); } else { fromUnsigned((unsigned long)value, base); }
+    }
+    void fromUnsigned(unsigned long value, unsigned char base) {
+        char buf[8 * sizeof(long) + 1];
+        char* pos = buf + sizeof(buf) - 1;
+        *pos = 0;
+        do {
+            unsigned long digit = value % base;
+            *--pos = char(digit < 10 ? '0' + digit : 'A' + digit - 10);
+            value /= base;
+        } while (value > 0);
+        _s = pos;
+    }
+    void fromDouble(double value, unsigned char decimalPlaces) {
+        char buf[33];
+        snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
+        _s = buf;
+    }
+
+    std::string _s;
+};
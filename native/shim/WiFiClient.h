@@ -0,0 +1,48 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Host implementation of the ESP8266 WiFiClient using the loopback broker
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include "Arduino.h"
+#include "IPAddress.h"
+
+class WiFiClient : public Print {
+public:
+    WiFiClient() : _connected(false), _timeout(1000), _readPos(0) {}
+    int connect(const char* host, uint16_t port);
+    int connect(const String& host, uint16_t port) { return connect(host.c_str(), port); }
+    int connect(IPAddress ip, uint16_t port) { return connect(ip.toString(), port); }
+    uint8_t connected();
+    operator bool() { return connected(); }
+    virtual size_t write(uint8_t c) { return write(&c, 1); }
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    using Print::write;
+    int available();
+    int read();
+    int read(uint8_t* buffer, size_t size);
+    int peek();
+    String readStringUntil(char terminator);
+    void stop();
+    void setNoDelay(bool) {}
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+    void keepAlive() {}
+    int availableForWrite() { return _connected ? 1460 : 0; }
+    virtual void flush() {}
+private:
+    void processRequest();
+    bool _connected;
+    unsigned long _timeout;
+    std::string _request;
+    std::string _response;
+    size_t _readPos;
+};
@@ -6,13 +6,15 @@
  * @author Volker Böhm
  * @copyright Copyright (c) 2020 Volker Böhm
  * @brief
- * Provides a web page with a configuration form
+ * Host implementation of the I2C interface, no device ever answers
  */
-#pragma once
 
-const char* htmlStart = R"htmlstart(
-<!DOCTYPE html>
-<html>
-<head>
-<meta name="viewport" content="width=device-width, initial-scale=1">
-)htmlstart";
+#pragma once
+#include <stdint.h>
+class TwoWire {
+public:
+    void begin() {}
+    void beginTransmission(uint8_t) {}
+    uint8_t endTransmission() { return 2; }
+};
+extern TwoWire Wire;
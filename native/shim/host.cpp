@@ -0,0 +1,411 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Host implementation of the Arduino/ESP8266 runtime used by the native environment
+ */
+
+#include <stdio.h>
+#include <map>
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "Wire.h"
+#include "ESP8266WiFi.h"
+#include "ESP8266HTTPClient.h"
+#include "ESP8266WebServer.h"
+#include "loopback.h"
+
+static uint64_t simulatedMicros = 0;
+static uint8_t pinState[32];
+static uint8_t rtcMemory[768];
+static rst_info resetInfo = { REASON_DEFAULT_RST };
+
+HardwareSerial Serial;
+EspClass ESP;
+EEPROMClass EEPROM;
+TwoWire Wire;
+ESP8266WiFiClass WiFi;
+
+unsigned long millis() { return (unsigned long)(simulatedMicros / 1000); }
+unsigned long micros() { return (unsigned long)simulatedMicros; }
+void delay(unsigned long ms) { Loopback::advanceMicros(uint64_t(ms) * 1000); WiFi.poll(); }
+void yield() { WiFi.poll(); }
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t pin, uint8_t value) { pinState[pin % 32] = value; }
+int digitalRead(uint8_t pin) { return pinState[pin % 32]; }
+int analogRead(uint8_t) { return 88; }
+void attachInterrupt(uint8_t, void (*)(), int) {}
+
+size_t HardwareSerial::write(uint8_t c) { return fwrite(&c, 1, 1, stderr); }
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) { return fwrite(buffer, 1, size, stderr); }
+
+void EspClass::deepSleep(uint64_t timeUs, RFMode mode) {
+    simulatedMicros += timeUs;
+    resetInfo.reason = REASON_DEEP_SLEEP_AWAKE;
+}
+rst_info* EspClass::getResetInfoPtr() { return &resetInfo; }
+
+bool system_rtc_mem_read(uint8_t srcAddr, void* desAddr, uint16_t loadSize) {
+    if (srcAddr < 64 || (srcAddr - 64) * 4 + loadSize > 512) {
+        return false;
+    }
+    memcpy(desAddr, rtcMemory + srcAddr * 4, loadSize);
+    return true;
+}
+bool system_rtc_mem_write(uint8_t desAddr, const void* srcAddr, uint16_t saveSize) {
+    if (desAddr < 64 || (desAddr - 64) * 4 + saveSize > 512) {
+        return false;
+    }
+    memcpy(rtcMemory + desAddr * 4, srcAddr, saveSize);
+    return true;
+}
+uint32_t system_get_free_heap_size() { return 40000; }
+uint32_t system_get_rtc_time() { return (uint32_t)simulatedMicros; }
+void gpio_pin_wakeup_enable(uint32_t, GPIO_INT_TYPE) {}
+void gpio_pin_wakeup_disable() {}
+
+void EEPROMClass::begin(size_t size) { _size = size < sizeof(_data) ? size : sizeof(_data); }
+uint8_t EEPROMClass::read(int address) { return address < int(_size) ? _data[address] : 0; }
+void EEPROMClass::write(int address, uint8_t value) { if (address < int(_size)) _data[address] = value; }
+bool EEPROMClass::commit() { _commitAmount++; return true; }
+
+/* --------------------------------------------------------------------------------------------- */
+/* Loopback broker                                                                               */
+/* --------------------------------------------------------------------------------------------- */
+
+namespace Loopback {
+    static THandlerFunction _handler;
+    static uint32_t _connectLatency = 0;
+    static uint32_t _requestLatency = 0;
+    static uint32_t _connectAmount = 0;
+    static uint32_t _requestAmount = 0;
+
+    void setHandler(THandlerFunction handler) { _handler = handler; }
+    void setLatency(uint32_t connectMs, uint32_t requestMs) { _connectLatency = connectMs; _requestLatency = requestMs; }
+    bool connect() {
+        if (!_handler) {
+            return false;
+        }
+        _connectAmount++;
+        advanceMicros(uint64_t(_connectLatency) * 1000);
+        return true;
+    }
+    int request(const String& method, const String& uri, const headers_t& headers, const String& body, String& response) {
+        _requestAmount++;
+        advanceMicros(uint64_t(_requestLatency) * 1000);
+        return _handler ? _handler(method, uri, headers, body, response) : -1;
+    }
+    uint32_t getConnectAmount() { return _connectAmount; }
+    uint32_t getRequestAmount() { return _requestAmount; }
+    void resetStatistics() { _connectAmount = 0; _requestAmount = 0; }
+    void advanceMicros(uint64_t micros) { simulatedMicros += micros; }
+}
+
+/* --------------------------------------------------------------------------------------------- */
+/* WiFiClient, speaks plain HTTP/1.1 to the loopback broker                                      */
+/* --------------------------------------------------------------------------------------------- */
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+    stop();
+    _connected = Loopback::connect();
+    return _connected ? 1 : 0;
+}
+
+uint8_t WiFiClient::connected() { return _connected || available() > 0; }
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+    if (!_connected) {
+        return 0;
+    }
+    _request.append((const char*)buffer, size);
+    processRequest();
+    return size;
+}
+
+static std::string getHeaderValue(const std::string& head, const char* name) {
+    std::string lowerHead = head;
+    std::transform(lowerHead.begin(), lowerHead.end(), lowerHead.begin(), ::tolower);
+    std::string key = std::string("\r\n") + name + ":";
+    size_t pos = lowerHead.find(key);
+    if (pos == std::string::npos) {
+        return "";
+    }
+    pos += key.length();
+    size_t end = head.find("\r\n", pos);
+    std::string value = head.substr(pos, end - pos);
+    value.erase(0, value.find_first_not_of(' '));
+    return value;
+}
+
+void WiFiClient::processRequest() {
+    size_t headEnd = _request.find("\r\n\r\n");
+    if (headEnd == std::string::npos) {
+        return;
+    }
+    std::string head = _request.substr(0, headEnd);
+    size_t contentLength = atoi(getHeaderValue(head, "content-length").c_str());
+    if (_request.length() < headEnd + 4 + contentLength) {
+        return;
+    }
+    std::string body = _request.substr(headEnd + 4, contentLength);
+    _request.erase(0, headEnd + 4 + contentLength);
+
+    size_t methodEnd = head.find(' ');
+    size_t uriEnd = head.find(' ', methodEnd + 1);
+    Loopback::headers_t headers;
+    size_t lineStart = head.find("\r\n");
+    while (lineStart != std::string::npos) {
+        size_t lineEnd = head.find("\r\n", lineStart + 2);
+        std::string line = head.substr(lineStart + 2, lineEnd == std::string::npos ? std::string::npos : lineEnd - lineStart - 2);
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+            std::string value = line.substr(colon + 1);
+            value.erase(0, value.find_first_not_of(' '));
+            headers.push_back(std::make_pair(String(line.substr(0, colon)), String(value)));
+        }
+        lineStart = lineEnd;
+    }
+    String response;
+    int code = Loopback::request(String(head.substr(0, methodEnd)),
+        String(head.substr(methodEnd + 1, uriEnd - methodEnd - 1)), headers, String(body), response);
+    char statusLine[128];
+    snprintf(statusLine, sizeof(statusLine), "HTTP/1.1 %d OK\r\nContent-Length: %u\r\nConnection: keep-alive\r\n\r\n",
+        code, response.length());
+    _response.erase(0, _readPos);
+    _readPos = 0;
+    _response += statusLine;
+    _response += response.c_str();
+}
+
+int WiFiClient::available() { return int(_response.length() - _readPos); }
+int WiFiClient::read() { return available() > 0 ? (uint8_t)_response[_readPos++] : -1; }
+int WiFiClient::peek() { return available() > 0 ? (uint8_t)_response[_readPos] : -1; }
+int WiFiClient::read(uint8_t* buffer, size_t size) {
+    size_t amount = std::min(size, size_t(available()));
+    memcpy(buffer, _response.data() + _readPos, amount);
+    _readPos += amount;
+    return amount;
+}
+String WiFiClient::readStringUntil(char terminator) {
+    String result;
+    int ch;
+    while ((ch = read()) >= 0 && ch != terminator) {
+        result += char(ch);
+    }
+    return result;
+}
+void WiFiClient::stop() {
+    _connected = false;
+    _request.clear();
+    _response.clear();
+    _readPos = 0;
+}
+
+/* --------------------------------------------------------------------------------------------- */
+/* HTTPClient                                                                                    */
+/* --------------------------------------------------------------------------------------------- */
+
+int HTTPClient::sendRequest(const char* type, const String& payload) {
+    _response = "";
+    if (_client == 0) {
+        return HTTPC_ERROR_CONNECTION_FAILED;
+    }
+    // url format http://host:port/uri
+    int hostStart = _url.indexOf("//") + 2;
+    int uriStart = _url.indexOf('/', hostStart);
+    String uri = uriStart < 0 ? String("/") : _url.substring(uriStart);
+    if (!_reuse || !_client->connected()) {
+        if (!_client->connect(_url.substring(hostStart, uriStart), 80)) {
+            return HTTPC_ERROR_CONNECTION_FAILED;
+        }
+    }
+    String request = String(type) + " " + uri + " HTTP/1.1\r\n";
+    for (auto const& header: _headers) {
+        request += header.first + ": " + header.second + "\r\n";
+    }
+    request += "Content-Length: " + String(payload.length()) + "\r\n\r\n";
+    request += payload;
+    _client->print(request);
+
+    String statusLine = _client->readStringUntil('\n');
+    int code = atoi(statusLine.c_str() + statusLine.indexOf(' ') + 1);
+    size_t contentLength = 0;
+    for (;;) {
+        String line = _client->readStringUntil('\n');
+        if (line == "\r" || line == "") {
+            break;
+        }
+        line.toLowerCase();
+        if (line.startsWith("content-length:")) {
+            contentLength = atoi(line.c_str() + 15);
+        }
+    }
+    for (size_t i = 0; i < contentLength; i++) {
+        _response += char(_client->read());
+    }
+    if (!_reuse) {
+        _client->stop();
+    }
+    return code;
+}
+
+/* --------------------------------------------------------------------------------------------- */
+/* ESP8266WebServer                                                                              */
+/* --------------------------------------------------------------------------------------------- */
+
+String ESP8266WebServer::arg(const String& name) {
+    for (auto const& arg: _args) {
+        if (arg.first == name) {
+            return arg.second;
+        }
+    }
+    return String();
+}
+
+bool ESP8266WebServer::hasArg(const String& name) {
+    for (auto const& arg: _args) {
+        if (arg.first == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+String ESP8266WebServer::header(const String& name) {
+    for (auto const& header: _requestHeaders) {
+        if (header.first.equalsIgnoreCase(name)) {
+            return header.second;
+        }
+    }
+    return String();
+}
+
+bool ESP8266WebServer::hasHeader(const String& name) {
+    for (auto const& header: _requestHeaders) {
+        if (header.first.equalsIgnoreCase(name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ESP8266WebServer::send(int code, const char* contentType, const String& content) {
+    send(code, contentType, content.c_str(), content.length());
+}
+
+void ESP8266WebServer::send(int code, const char* contentType, const char* content, size_t contentLength) {
+    _responseCode = code;
+    _responseBody = String(content, contentLength);
+    _responseChunks = _contentLength == CONTENT_LENGTH_UNKNOWN ? 0 : 1;
+    _maxChunkSize = contentLength;
+}
+
+void ESP8266WebServer::sendContent(const char* content, size_t size) {
+    _responseBody.concat(content, size);
+    _responseChunks++;
+    _maxChunkSize = std::max(_maxChunkSize, size);
+}
+
+int ESP8266WebServer::handleRequest(HTTPMethod method, const String& uri, const String& body,
+    const std::vector<std::pair<String, String>>& args,
+    const std::vector<std::pair<String, String>>& headers) 
+{
+    _method = method;
+    _uri = uri;
+    _args = args;
+    if (body.length() > 0) {
+        _args.push_back(std::make_pair(String("plain"), body));
+    }
+    _requestHeaders = headers;
+    _responseHeaders.clear();
+    _responseBody = "";
+    _responseCode = 0;
+    _responseChunks = 0;
+    _maxChunkSize = 0;
+    _contentLength = CONTENT_LENGTH_NOT_SET;
+    for (auto const& handler: _handlers) {
+        if (handler.uri == uri && (handler.method == HTTP_ANY || handler.method == method)) {
+            handler.handler();
+            return _responseCode;
+        }
+    }
+    if (_notFoundHandler) {
+        _notFoundHandler();
+    }
+    return _responseCode;
+}
+
+/* --------------------------------------------------------------------------------------------- */
+/* WiFi                                                                                          */
+/* --------------------------------------------------------------------------------------------- */
+
+class WiFiEventHandlerOpaque {
+public:
+    std::function<void(const WiFiEventStationModeGotIP&)> onGotIP;
+    std::function<void(const WiFiEventStationModeDisconnected&)> onDisconnected;
+};
+
+ESP8266WiFiClass::ESP8266WiFiClass() 
+    : _mode(WIFI_STA), _sleepType(WIFI_NONE_SLEEP), _status(WL_DISCONNECTED), _connectDue(0),
+    _fullConnectTime(2500), _fastConnectTime(400), _staticIP(false), _channel(6)
+{
+    const uint8_t bssid[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+    memcpy(_bssid, bssid, sizeof(_bssid));
+}
+
+wl_status_t ESP8266WiFiClass::begin(const char* ssid, const char* password, int32_t channel, const uint8_t* bssid, bool connect) {
+    bool fast = channel != 0 && bssid != 0 && _staticIP;
+    _status = WL_IDLE_STATUS;
+    _connectDue = millis() + (fast ? _fastConnectTime : _fullConnectTime);
+    return _status;
+}
+
+bool ESP8266WiFiClass::config(IPAddress localIP, IPAddress gateway, IPAddress subnet, IPAddress dns1, IPAddress dns2) {
+    _staticIP = localIP.isSet();
+    return true;
+}
+
+wl_status_t ESP8266WiFiClass::status() {
+    poll();
+    return _status;
+}
+
+bool ESP8266WiFiClass::disconnect(bool wifiOff) {
+    _status = WL_DISCONNECTED;
+    return true;
+}
+
+void ESP8266WiFiClass::poll() {
+    if (_status == WL_IDLE_STATUS && millis() >= _connectDue) {
+        _status = WL_CONNECTED;
+        _ip = IPAddress(192, 168, 0, 42);
+        _gateway = IPAddress(192, 168, 0, 1);
+        _mask = IPAddress(255, 255, 255, 0);
+        _dns = IPAddress(192, 168, 0, 1);
+        WiFiEventStationModeGotIP event = { _ip, _mask, _gateway };
+        for (auto const& handler: _handlers) {
+            auto locked = handler.lock();
+            if (locked && locked->onGotIP) {
+                locked->onGotIP(event);
+            }
+        }
+    }
+}
+
+WiFiEventHandler ESP8266WiFiClass::onStationModeGotIP(std::function<void(const WiFiEventStationModeGotIP&)> handler) {
+    WiFiEventHandler result = std::make_shared<WiFiEventHandlerOpaque>();
+    result->onGotIP = handler;
+    _handlers.push_back(result);
+    return result;
+}
+
+WiFiEventHandler ESP8266WiFiClass::onStationModeDisconnected(std::function<void(const WiFiEventStationModeDisconnected&)> handler) {
+    WiFiEventHandler result = std::make_shared<WiFiEventHandlerOpaque>();
+    result->onDisconnected = handler;
+    _handlers.push_back(result);
+    return result;
+}
@@ -0,0 +1,59 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Host only: in-process stand-in for the yaha broker. WiFiClient and HTTPClient deliver their
+ * requests to the registered handler and advance the simulated clock by the configured latency.
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+#include <utility>
+#include "Arduino.h"
+
+namespace Loopback {
+
+    typedef std::vector<std::pair<String, String>> headers_t;
+    typedef std::function<int(const String& method, const String& uri, const headers_t& headers,
+        const String& body, String& response)> THandlerFunction;
+
+    /**
+     * Registers the handler answering all requests
+     */
+    void setHandler(THandlerFunction handler);
+
+    /**
+     * Sets the simulated network latency
+     * @param connectMs time to establish a tcp connection
+     * @param requestMs round trip time of a request
+     */
+    void setLatency(uint32_t connectMs, uint32_t requestMs);
+
+    /**
+     * Simulates a tcp connect, returns false, if no handler is registered
+     */
+    bool connect();
+
+    /**
+     * Passes a request to the handler
+     */
+    int request(const String& method, const String& uri, const headers_t& headers, const String& body, String& response);
+
+    /**
+     * Statistics
+     */
+    uint32_t getConnectAmount();
+    uint32_t getRequestAmount();
+    void resetStatistics();
+
+    /**
+     * Advances the simulated clock
+     */
+    void advanceMicros(uint64_t micros);
+}
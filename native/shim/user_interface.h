@@ -0,0 +1,50 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Host implementation of the ESP8266 SDK functions used by the station
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+enum rst_reason {
+    REASON_DEFAULT_RST = 0,
+    REASON_WDT_RST = 1,
+    REASON_EXCEPTION_RST = 2,
+    REASON_SOFT_WDT_RST = 3,
+    REASON_SOFT_RESTART = 4,
+    REASON_DEEP_SLEEP_AWAKE = 5,
+    REASON_EXT_SYS_RST = 6
+};
+
+struct rst_info {
+    uint32_t reason;
+};
+
+enum sleep_type {
+    NONE_SLEEP_T = 0,
+    LIGHT_SLEEP_T,
+    MODEM_SLEEP_T
+};
+
+enum GPIO_INT_TYPE {
+    GPIO_PIN_INTR_DISABLE = 0,
+    GPIO_PIN_INTR_POSEDGE = 1,
+    GPIO_PIN_INTR_NEGEDGE = 2,
+    GPIO_PIN_INTR_ANYEDGE = 3,
+    GPIO_PIN_INTR_LOLEVEL = 4,
+    GPIO_PIN_INTR_HILEVEL = 5
+};
+
+bool system_rtc_mem_read(uint8_t srcAddr, void* desAddr, uint16_t loadSize);
+bool system_rtc_mem_write(uint8_t desAddr, const void* srcAddr, uint16_t saveSize);
+uint32_t system_get_free_heap_size();
+uint32_t system_get_rtc_time();
+void gpio_pin_wakeup_enable(uint32_t pin, GPIO_INT_TYPE intrState);
+void gpio_pin_wakeup_disable();
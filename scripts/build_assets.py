@@ -0,0 +1,254 @@
+"""
+This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+"as is", without any support, and with no warranty, express or implied, as to its usefulness for
+any purpose.
+
+@author Volker Böhm
+@copyright Copyright (c) 2020 Volker Böhm
+@brief
+Generates PROGMEM arrays for the web configuration ui from the sources in web/
+
+- web/static/*   files served as they are, minified and gzip compressed, listed in a manifest
+- web/head.html  start of every page up to the body, minified
+- web/forms/*    form templates, minified but not compressed, as the device fills in the values
+
+Used as PlatformIO pre build script (extra_scripts = pre:scripts/build_assets.py) or on the host:
+    python scripts/build_assets.py [--check] [project_dir]
+--check does not write anything and fails, if the generated files are not up to date.
+"""
+
+import gzip
+import os
+import re
+import sys
+
+OUTPUT_DIR = os.path.join("lib", "assets")
+HEADER_NAME = "assets.h"
+SOURCE_NAME = "assets.cpp"
+
+CONTENT_TYPES = {
+    ".css": "text/css",
+    ".html": "text/html",
+    ".js": "application/javascript",
+    ".ico": "image/x-icon",
+    ".svg": "image/svg+xml",
+}
+
+GENERATED_NOTE = "Generated by scripts/build_assets.py from web/, do not edit"
+
+
+def minify_css(text):
+    """Removes comments and all whitespace not needed"""
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"\s+", " ", text)
+    text = re.sub(r"\s*([{};:,>])\s*", r"\1", text)
+    text = text.replace(";}", "}")
+    return text.strip()
+
+
+def minify_html(text):
+    """Removes whitespace between tags and collapses all other whitespace to one blank"""
+    text = re.sub(r"<!--.*?-->", "", text, flags=re.S)
+    text = re.sub(r">\s+<", "><", text)
+    text = re.sub(r"\s+", " ", text)
+    return text.strip()
+
+
+def minify(name, data):
+    extension = os.path.splitext(name)[1]
+    if extension == ".css":
+        return minify_css(data.decode("utf-8")).encode("utf-8")
+    if extension == ".html":
+        return minify_html(data.decode("utf-8")).encode("utf-8")
+    return data
+
+
+def compress(data):
+    """gzip with fixed header (no file name, mtime 0), thus the result is reproducible"""
+    return gzip.compress(data, compresslevel=9, mtime=0)
+
+
+def fnv1a(data):
+    """32 bit FNV-1a hash, the same function as hashP in lib/utils/hash.h"""
+    result = 2166136261
+    for byte in data:
+        result = ((result ^ byte) * 16777619) & 0xFFFFFFFF
+    return result
+
+
+def to_identifier(name):
+    """Converts a file name to a lower camel case identifier, e.g. css.css -> cssCss"""
+    parts = [part for part in re.split(r"[^0-9a-zA-Z]+", name) if part]
+    return parts[0].lower() + "".join(part[:1].upper() + part[1:] for part in parts[1:])
+
+
+def to_string_literal(data, indent="    ", width=100):
+    """Converts bytes to a C string literal, split into lines. Octal escapes always have three
+    digits, thus they cannot merge with a following digit"""
+    lines = []
+    line = ""
+    for byte in data:
+        char = chr(byte)
+        if char in "\"\\?":
+            char = "\\" + char
+        elif byte < 32 or byte > 126:
+            char = "\\%03o" % byte
+        if len(line) + len(char) > width:
+            lines.append(line)
+            line = ""
+        line += char
+    lines.append(line)
+    return "\n".join(indent + '"' + line + '"' for line in lines)
+
+
+def to_byte_array(data, indent="    ", per_line=16):
+    lines = []
+    for pos in range(0, len(data), per_line):
+        lines.append(indent + ", ".join("0x%02x" % byte for byte in data[pos:pos + per_line]))
+    return ",\n".join(lines)
+
+
+def read_sources(project_dir):
+    """Reads all sources from web/ in a stable order"""
+    web_dir = os.path.join(project_dir, "web")
+
+    def read_dir(sub_dir):
+        directory = os.path.join(web_dir, sub_dir)
+        if not os.path.isdir(directory):
+            return []
+        result = []
+        for name in sorted(os.listdir(directory)):
+            with open(os.path.join(directory, name), "rb") as file:
+                result.append((name, file.read()))
+        return result
+
+    with open(os.path.join(web_dir, "head.html"), "rb") as file:
+        head = file.read()
+    return read_dir("static"), head, read_dir("forms")
+
+
+def generate(project_dir):
+    """Creates the content of the generated header and source file
+    @returns (header, source, statistics)"""
+    static_files, head, forms = read_sources(project_dir)
+    header = [
+        "/**",
+        " * " + GENERATED_NOTE,
+        " * @brief",
+        " * Static files and html templates of the web configuration ui stored in flash",
+        " */",
+        "#pragma once",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "/**",
+        " * Static file served under a fixed path",
+        " */",
+        "struct StaticAsset {",
+        "    const char* path;",
+        "    const char* contentType;",
+        "    const char* etag;",
+        "    PGM_P data;",
+        "    uint16_t length;",
+        "    bool isGzip;",
+        "};",
+        "",
+        "extern const StaticAsset staticAssets[];",
+        "extern const uint8_t staticAssetCount;",
+        "",
+        "extern const char headHtml[];",
+    ]
+    source = [
+        "/**",
+        " * " + GENERATED_NOTE,
+        " */",
+        "",
+        '#include "assets.h"',
+        "",
+    ]
+    statistics = []
+    manifest = []
+
+    for name, data in static_files:
+        minified = minify(name, data)
+        compressed = compress(minified)
+        identifier = to_identifier(name) + "Gz"
+        source.append("static const uint8_t %s[] PROGMEM = {" % identifier)
+        source.append(to_byte_array(compressed))
+        source.append("};")
+        source.append("")
+        content_type = CONTENT_TYPES.get(os.path.splitext(name)[1], "application/octet-stream")
+        manifest.append('    { "/%s", "%s", "\\"%08x\\"", (PGM_P) %s, %d, true }' % (
+            name, content_type, fnv1a(compressed), identifier, len(compressed)))
+        statistics.append((name, len(data), len(compressed)))
+
+    source.append("const StaticAsset staticAssets[] = {")
+    source.append(",\n".join(manifest))
+    source.append("};")
+    source.append("const uint8_t staticAssetCount = %d;" % len(manifest))
+    source.append("")
+
+    minified = minify("head.html", head)
+    source.append("const char headHtml[] PROGMEM =")
+    source.append(to_string_literal(minified) + ";")
+    source.append("")
+    statistics.append(("head.html", len(head), len(minified)))
+
+    for name, data in forms:
+        identifier = to_identifier(os.path.splitext(name)[0]) + "Form"
+        minified = minify(name, data)
+        header.append("extern const char %s[];" % identifier)
+        source.append("const char %s[] PROGMEM =" % identifier)
+        source.append(to_string_literal(minified) + ";")
+        source.append("")
+        statistics.append(("forms/" + name, len(data), len(minified)))
+
+    header.append("")
+    return "\n".join(header), "\n".join(source), statistics
+
+
+def read_file(path):
+    if not os.path.exists(path):
+        return None
+    with open(path, "r", encoding="utf-8") as file:
+        return file.read()
+
+
+def build(project_dir, check=False):
+    """Generates the asset files, writes only files with changed content to avoid rebuilds
+    @returns True, if the files were up to date"""
+    header, source, statistics = generate(project_dir)
+    output_dir = os.path.join(project_dir, OUTPUT_DIR)
+    up_to_date = True
+    for name, content in ((HEADER_NAME, header), (SOURCE_NAME, source)):
+        path = os.path.join(output_dir, name)
+        if read_file(path) == content:
+            continue
+        up_to_date = False
+        if not check:
+            os.makedirs(output_dir, exist_ok=True)
+            with open(path, "w", encoding="utf-8", newline="\n") as file:
+                file.write(content)
+            print("build_assets: generated " + path)
+    return up_to_date, statistics
+
+
+def main(args):
+    check = "--check" in args
+    paths = [arg for arg in args if not arg.startswith("--")]
+    project_dir = paths[0] if paths else os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    up_to_date, statistics = build(project_dir, check)
+    for name, original, generated in statistics:
+        print("%-24s %6d -> %6d bytes" % (name, original, generated))
+    if check and not up_to_date:
+        print("build_assets: generated files are outdated, run scripts/build_assets.py")
+        return 1
+    return 0
+
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO (SCons)
+    build(env.subst("$PROJECT_DIR"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        sys.exit(main(sys.argv[1:]))
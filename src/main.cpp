@@ -20,6 +20,9 @@
 // #define __BATTERY
 // #define __RTC
 // #define __RAIN
+// #define __DIAG    // Publishes heap statistics and wake cycle timings as diag/... messages
+// #define __SAMPLING // Battery mode connects only every UPLOAD_INTERVAL'th wake, the other wakes store samples
+// #define __LIGHT_SLEEP // Light sleep between the tasks, if not in battery mode. Closes the access point
 
 #include <vector>
 #include <debug.h>
@@ -62,6 +65,16 @@ const uint8_t ACTIVATE_RAIN_PIN = D7;
 #include "softap.h"
 #endif
 
+#ifdef __DIAG
+#include "heapmonitor.h"
+#include "profiler.h"
+#include "powermonitor.h"
+#endif
+
+#ifdef __SAMPLING
+const uint8_t UPLOAD_INTERVAL = 4;
+#endif
+
 const uint32_t SERIAL_SPEED = 115200;
 const char* AP_NAME = "YAHA_ESP_AP";
 
@@ -85,6 +98,9 @@ void setup() {
     #endif
     #ifdef __BME
     server.addDevice(new YahaBME280(BME_I2C_ADDRESS, ACTIVATE_BME280_PIN));
+    server.publishFilter.setDeadband("sensor/temperature", 0.1);
+    server.publishFilter.setDeadband("sensor/humidity", 0.5);
+    server.publishFilter.setDeadband("sensor/pressure", 50);
     #endif
     #ifdef __IRRIGATION
     server.addDevice(new Irrigation());
@@ -95,10 +111,21 @@ void setup() {
     #ifdef __MOTION
     server.addDevice(new Motion());
     #endif
+    #ifdef __DIAG
+    server.addDevice(new HeapMonitor());
+    server.addDevice(new Profiler());
+    server.addDevice(new PowerMonitor());
+    #endif
     #ifdef __SOFT_AP
     // AP must be created before connecting to WLAN. This is done by applying priority 1
     server.addDevice(new SoftAP(), 1);
     #endif
+    #ifdef __SAMPLING
+    server.enableSampling(UPLOAD_INTERVAL);
+    #endif
+    #ifdef __LIGHT_SLEEP
+    server.enableLightSleep();
+    #endif
     server.setup(AP_NAME);
 }
 
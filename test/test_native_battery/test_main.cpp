@@ -0,0 +1,119 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Native tests of the battery configuration
+ * pio test -e native
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <eepromaccess.h>
+#include <battery.h>
+
+/**
+ * EEPROM record of the battery configuration before the sleep time bounds were added
+ */
+struct ConfigurationLayout1 {
+    uint16_t normalVoltageSleepTimeInSeconds;
+    uint16_t highVoltageSleepTimeInSeconds;
+    uint16_t lowVoltageSleepTimeInSeconds;
+    uint8_t batteryMode;
+    float voltageCalibrationDivisor;
+    float highVoltage;
+    float lowVoltage;
+};
+
+/**
+ * Message broker keeping the last value of every message
+ */
+class RecordingBroker : public IMessageBroker {
+public:
+    virtual void sendMessageToDevices(const String& key, const String& value) { messages.set(key, value); }
+    Properties messages;
+};
+
+static const uint32_t NEXT_DEVICE_CONFIG = 0x12345678;
+static RecordingBroker broker;
+
+static Properties getConfig(const char* minSleepTime, const char* maxSleepTime) {
+    Properties result = Battery().getConfig();
+    result.set("battery/minSleepTimeInSeconds", minSleepTime);
+    result.set("battery/maxSleepTimeInSeconds", maxSleepTime);
+    return result;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_layout_1_is_migrated_without_shifting_next_device() {
+    ConfigurationLayout1 layout1 = { 600, 60, 7200, 1, 23.5, 3.6, 3.0 };
+    EEPROMAccess::write(0, (const uint8_t*) &layout1, sizeof(layout1));
+    EEPROMAccess::write(sizeof(layout1), (const uint8_t*) &NEXT_DEVICE_CONFIG, sizeof(NEXT_DEVICE_CONFIG));
+
+    Battery battery;
+    uint16_t address = battery.readConfigFromEEPROM(0);
+    TEST_ASSERT_EQUAL(sizeof(layout1), address);
+    uint32_t nextDeviceConfig = 0;
+    EEPROMAccess::read(address, (uint8_t*) &nextDeviceConfig, sizeof(nextDeviceConfig));
+    TEST_ASSERT_EQUAL(NEXT_DEVICE_CONFIG, nextDeviceConfig);
+
+    Properties config = battery.getConfig();
+    TEST_ASSERT_EQUAL(600, config.get("battery/normalVoltageSleepTimeInSeconds").toInt());
+    TEST_ASSERT_EQUAL(7200, config.get("battery/lowVoltageSleepTimeInSeconds").toInt());
+    TEST_ASSERT_EQUAL_STRING("on", config.get("battery/mode").c_str());
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 23.5, config.get("battery/voltageCalibrationDivisor").toFloat());
+    TEST_ASSERT_EQUAL(120, config.get("battery/minSleepTimeInSeconds").toInt());
+    TEST_ASSERT_EQUAL(3600, config.get("battery/maxSleepTimeInSeconds").toInt());
+}
+
+static void test_current_layout_is_read_back() {
+    Battery battery;
+    battery.setMessageBroker(&broker);
+    battery.setConfig(getConfig("300", "1200"));
+    uint16_t address = battery.writeConfigToEEPROM(0);
+    EEPROMAccess::write(address, (const uint8_t*) &NEXT_DEVICE_CONFIG, sizeof(NEXT_DEVICE_CONFIG));
+
+    Battery restored;
+    TEST_ASSERT_EQUAL(address, restored.readConfigFromEEPROM(0));
+    TEST_ASSERT_EQUAL(300, restored.getConfig().get("battery/minSleepTimeInSeconds").toInt());
+    TEST_ASSERT_EQUAL(1200, restored.getConfig().get("battery/maxSleepTimeInSeconds").toInt());
+}
+
+static void test_min_sleep_time_is_limited_to_max() {
+    Battery battery;
+    battery.setMessageBroker(&broker);
+    battery.setConfig(getConfig("4000", "1000"));
+    TEST_ASSERT_EQUAL(1000, battery.getConfig().get("battery/minSleepTimeInSeconds").toInt());
+    battery.setConfig(getConfig("4000", "0"));
+    TEST_ASSERT_EQUAL(4000, battery.getConfig().get("battery/minSleepTimeInSeconds").toInt());
+}
+
+static void test_sleep_time_is_limited_to_deep_sleep_max() {
+    const uint64_t MICROSECONDS_IN_A_SECOND = 1000000;
+    uint16_t deepSleepMaxInSeconds = ESP.deepSleepMax() / MICROSECONDS_IN_A_SECOND;
+    Properties config = getConfig("20000", "0");
+    config.set("battery/highVoltageSleepTimeInSeconds", "50000");
+    config.set("battery/normalVoltageSleepTimeInSeconds", "50000");
+    config.set("battery/lowVoltageSleepTimeInSeconds", "50000");
+    Battery battery;
+    battery.setMessageBroker(&broker);
+    battery.setConfig(config);
+    TEST_ASSERT_EQUAL(deepSleepMaxInSeconds, battery.getSleepTimeInSeconds());
+    battery.closeDown();
+    TEST_ASSERT_EQUAL(deepSleepMaxInSeconds, broker.messages.get("battery/sleepTimeInSeconds").toInt());
+}
+
+int main(int argc, char** argv) {
+    EEPROMAccess::init();
+    UNITY_BEGIN();
+    RUN_TEST(test_layout_1_is_migrated_without_shifting_next_device);
+    RUN_TEST(test_current_layout_is_read_back);
+    RUN_TEST(test_min_sleep_time_is_limited_to_max);
+    RUN_TEST(test_sleep_time_is_limited_to_deep_sleep_max);
+    return UNITY_END();
+}
@@ -0,0 +1,104 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Native tests of the batch publish and its fallback to single messages
+ * pio test -e native
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <loopback.h>
+#include <brokerproxy.h>
+
+static const uint32_t WLAN_CONNECT_TIME = 3000;
+static const uint32_t FLUSH_TIMEOUT = 1000;
+
+static String requestedURIs;
+static std::vector<int> batchStatusCodes;
+
+/**
+ * Records the uri of every publish request, answers batches with the next code of 
+ * batchStatusCodes and all other requests with 200
+ */
+static int handleBrokerRequest(const String& method, const String& uri, const Loopback::headers_t& headers,
+    const String& body, String& response) 
+{
+    requestedURIs += uri + " ";
+    if (uri == "/publish/batch" && !batchStatusCodes.empty()) {
+        int result = batchStatusCodes.front();
+        batchStatusCodes.erase(batchStatusCodes.begin());
+        return result;
+    }
+    return 200;
+}
+
+/**
+ * Queues three messages and sends them
+ * @returns true, if the queue is empty afterwards
+ */
+static bool publish(BrokerProxy& proxy) {
+    Messages_t messages;
+    for (int i = 1; i <= 3; i++) {
+        messages.push_back(Message("area/device/sensor/" + String(i), String(i)));
+    }
+    proxy.publishMessages(messages, false, 1);
+    return proxy.flush(FLUSH_TIMEOUT);
+}
+
+void setUp() {
+    requestedURIs = "";
+    batchStatusCodes.clear();
+}
+
+void tearDown() {}
+
+static void test_messages_are_sent_in_one_batch() {
+    BrokerProxy proxy;
+    TEST_ASSERT_TRUE(publish(proxy));
+    TEST_ASSERT_EQUAL_STRING("/publish/batch ", requestedURIs.c_str());
+}
+
+static void test_missing_batch_endpoint_falls_back_to_single_messages() {
+    const int notSupported[] = { 404, 405, 501 };
+    for (auto statusCode: notSupported) {
+        BrokerProxy proxy;
+        requestedURIs = "";
+        batchStatusCodes = { statusCode };
+        TEST_ASSERT_TRUE(publish(proxy));
+        TEST_ASSERT_EQUAL_STRING("/publish/batch /publish /publish /publish ", requestedURIs.c_str());
+        requestedURIs = "";
+        TEST_ASSERT_TRUE(publish(proxy));
+        TEST_ASSERT_EQUAL_STRING("/publish /publish /publish ", requestedURIs.c_str());
+    }
+}
+
+static void test_transient_errors_retry_the_batch() {
+    const int transient[] = { 401, 408, 500, 503 };
+    for (auto statusCode: transient) {
+        BrokerProxy proxy;
+        requestedURIs = "";
+        batchStatusCodes = { statusCode };
+        TEST_ASSERT_TRUE(publish(proxy));
+        TEST_ASSERT_EQUAL_STRING("/publish/batch /publish/batch ", requestedURIs.c_str());
+        requestedURIs = "";
+        TEST_ASSERT_TRUE(publish(proxy));
+        TEST_ASSERT_EQUAL_STRING("/publish/batch ", requestedURIs.c_str());
+    }
+}
+
+int main(int argc, char** argv) {
+    Loopback::setHandler(handleBrokerRequest);
+    WiFi.begin("home");
+    delay(WLAN_CONNECT_TIME);
+    UNITY_BEGIN();
+    RUN_TEST(test_messages_are_sent_in_one_batch);
+    RUN_TEST(test_missing_batch_endpoint_falls_back_to_single_messages);
+    RUN_TEST(test_transient_errors_retry_the_batch);
+    return UNITY_END();
+}
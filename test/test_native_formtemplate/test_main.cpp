@@ -0,0 +1,82 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Native tests of the preparsed html form templates
+ * pio test -e native
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <properties.h>
+#include <formtemplate.h>
+
+/**
+ * Output collecting everything written in a string
+ */
+class StringPrint : public Print {
+public:
+    virtual size_t write(uint8_t c) { result += char(c); return 1; }
+    using Print::write;
+    String result;
+};
+
+static const char form[] PROGMEM = 
+    "<input name=\"a/b\" [value]=\"a/b\">"
+    "<input type=\"checkbox\" [checked]=\"a/on\">"
+    "<input [value]=\"missing\">[other]";
+
+void setUp() {}
+void tearDown() {}
+
+static void test_render_fills_values_and_checkboxes() {
+    FormTemplate formTemplate(form);
+    Properties data;
+    data.set("a/b", "21.5");
+    data.set("a/on", "on");
+    StringPrint out;
+    formTemplate.render(data, out);
+    TEST_ASSERT_EQUAL_STRING(
+        "<input name=\"a/b\" value=\"21.5\">"
+        "<input type=\"checkbox\" checked=\"checked\">"
+        "<input value=\"\">[other]", out.result.c_str());
+}
+
+static void test_render_leaves_unchecked_checkboxes_empty() {
+    FormTemplate formTemplate(form);
+    Properties data;
+    data.set("a/on", "off");
+    StringPrint out;
+    formTemplate.render(data, out);
+    TEST_ASSERT_EQUAL_STRING(
+        "<input name=\"a/b\" value=\"\">"
+        "<input type=\"checkbox\" >"
+        "<input value=\"\">[other]", out.result.c_str());
+}
+
+static void test_template_without_slots_is_copied() {
+    static const char plain[] PROGMEM = "<p>[value]=unterminated</p>";
+    FormTemplate formTemplate(plain);
+    StringPrint out;
+    formTemplate.render(Properties(), out);
+    TEST_ASSERT_EQUAL_STRING(plain, out.result.c_str());
+}
+
+static void test_hash_depends_on_content() {
+    static const char other[] PROGMEM = "<input [value]=\"a/c\">";
+    TEST_ASSERT_EQUAL(FormTemplate(form).getHash(), FormTemplate(form).getHash());
+    TEST_ASSERT_TRUE(FormTemplate(form).getHash() != FormTemplate(other).getHash());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_render_fills_values_and_checkboxes);
+    RUN_TEST(test_render_leaves_unchecked_checkboxes_empty);
+    RUN_TEST(test_template_without_slots_is_copied);
+    RUN_TEST(test_hash_depends_on_content);
+    return UNITY_END();
+}
@@ -0,0 +1,178 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Native tests of the JSON tokenizer, the path resolver and the writer
+ * pio test -e native
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <jsontokenizer.h>
+#include <json.h>
+#include <jsonwriter.h>
+
+static const char publishBody[] =
+    "{\"message\":{\"topic\":\"area/room/device/switch/D4/set\",\"value\":\"on\","
+    "\"reason\":[{\"message\":\"first\"},{\"message\":\"second \\\"quoted\\\"\"}]},"
+    "\"qos\":1,\"retain\":false}";
+
+void setUp() {}
+void tearDown() {}
+
+static void test_tokenizer_scans_all_token_types() {
+    const char data[] = " { \"a\" : [ -1.5e3 , true , false , null ] } ";
+    const JSONTokenType expected[] = {
+        JSON_BEGIN_OBJECT, JSON_STRING, JSON_COLON, JSON_BEGIN_ARRAY, JSON_NUMBER, JSON_COMMA,
+        JSON_TRUE, JSON_COMMA, JSON_FALSE, JSON_COMMA, JSON_NULL, JSON_END_ARRAY, JSON_END_OBJECT, JSON_END
+    };
+    JSONTokenizer tokenizer(data, strlen(data));
+    for (auto type: expected) {
+        TEST_ASSERT_EQUAL(type, tokenizer.next().type);
+    }
+    TEST_ASSERT_FALSE(tokenizer.hasError());
+}
+
+static void test_tokenizer_reports_position_of_string_and_number() {
+    const char data[] = "[\"ab\\\"c\",42]";
+    JSONTokenizer tokenizer(data, strlen(data));
+    tokenizer.next();
+    JSONToken string = tokenizer.next();
+    TEST_ASSERT_EQUAL(JSON_STRING, string.type);
+    TEST_ASSERT_EQUAL(1, string.begin);
+    TEST_ASSERT_EQUAL(7, string.len);
+    tokenizer.next();
+    JSONToken number = tokenizer.next();
+    TEST_ASSERT_EQUAL(JSON_NUMBER, number.type);
+    TEST_ASSERT_EQUAL(9, number.begin);
+    TEST_ASSERT_EQUAL(2, number.len);
+}
+
+static void test_tokenizer_rejects_invalid_input() {
+    const char* invalid[] = { "\"unterminated", "tru", "-", "@" };
+    for (auto data: invalid) {
+        JSONTokenizer tokenizer(data, strlen(data));
+        TEST_ASSERT_EQUAL(JSON_ERROR, tokenizer.next().type);
+        TEST_ASSERT_TRUE(tokenizer.hasError());
+    }
+}
+
+static void test_tokenizer_skips_nested_values() {
+    const char data[] = "{\"a\":{\"b\":[1,{\"c\":2}]},\"d\":3}";
+    JSONTokenizer tokenizer(data, strlen(data));
+    tokenizer.next();
+    tokenizer.next();
+    tokenizer.next();
+    TEST_ASSERT_TRUE(tokenizer.skipValue(tokenizer.next()));
+    TEST_ASSERT_EQUAL(JSON_COMMA, tokenizer.next().type);
+    JSONToken name = tokenizer.next();
+    TEST_ASSERT_EQUAL(JSON_STRING, name.type);
+    TEST_ASSERT_EQUAL('d', data[name.begin + 1]);
+}
+
+static void test_json_resolves_nested_paths() {
+    JSON json(publishBody, strlen(publishBody));
+    TEST_ASSERT_EQUAL_STRING("area/room/device/switch/D4/set", json.getElement("message.topic").c_str());
+    TEST_ASSERT_EQUAL_STRING("on", json.getElement("message.value").c_str());
+    TEST_ASSERT_EQUAL_STRING("1", json.getElement("qos").c_str());
+    TEST_ASSERT_EQUAL_STRING("false", json.getElement("retain").c_str());
+}
+
+static void test_json_resolves_array_indices_and_unescapes() {
+    JSON json(publishBody, strlen(publishBody));
+    TEST_ASSERT_EQUAL_STRING("first", json.getElement("message.reason[0].message").c_str());
+    TEST_ASSERT_EQUAL_STRING("second \"quoted\"", json.getElement("message.reason[1].message").c_str());
+    JSONSpan span;
+    TEST_ASSERT_FALSE(json.findElement("message.reason[2].message", span));
+}
+
+static void test_json_resolves_several_paths_in_one_pass() {
+    JSON json(publishBody, strlen(publishBody));
+    const char* paths[] = { "retain", "message.topic", "missing", "qos" };
+    JSONSpan spans[4];
+    TEST_ASSERT_EQUAL(3, json.getElements(paths, spans));
+    TEST_ASSERT_EQUAL_STRING("false", json.getString(spans[0]).c_str());
+    TEST_ASSERT_EQUAL_STRING("area/room/device/switch/D4/set", json.getString(spans[1]).c_str());
+    TEST_ASSERT_FALSE(spans[2].isFound());
+    TEST_ASSERT_EQUAL_STRING("1", json.getString(spans[3]).c_str());
+}
+
+static void test_json_get_element_to_buffer_reports_truncation() {
+    JSON json(publishBody, strlen(publishBody));
+    char buffer[8];
+    TEST_ASSERT_TRUE(json.getElement("message.value", buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("on", buffer);
+    TEST_ASSERT_FALSE(json.getElement("message.topic", buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("area/ro", buffer);
+    TEST_ASSERT_FALSE(json.getElement("missing", buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("", buffer);
+}
+
+static void test_json_ignores_malformed_documents() {
+    const char data[] = "{\"a\":1,\"b\" 2}";
+    JSON json(data, strlen(data));
+    JSONSpan span;
+    TEST_ASSERT_FALSE(json.findElement("b", span));
+}
+
+static void test_json_parses_flat_object() {
+    String body("{\"battery/mode\":\"on\",\"battery/lowVoltage\":3.1,\"wlan/ssid\":\"a\\u00e4\"}");
+    Properties properties = JSON(body).parseObject("");
+    TEST_ASSERT_EQUAL(3, properties.size());
+    TEST_ASSERT_EQUAL_STRING("on", properties.get("battery/mode").c_str());
+    TEST_ASSERT_EQUAL_STRING("3.1", properties.get("battery/lowVoltage").c_str());
+    TEST_ASSERT_EQUAL_STRING("a\xC3\xA4", properties.get("wlan/ssid").c_str());
+}
+
+static void test_writer_writes_nested_containers() {
+    String result;
+    JSONWriter json(result);
+    json.beginObject()
+        .property("topic", "a/b")
+        .numberProperty("qos", -1)
+        .rawProperty("retain", "false")
+        .beginArray("values")
+            .value("x")
+            .rawValue("2")
+            .beginObject().endObject()
+        .endArray()
+    .endObject();
+    TEST_ASSERT_EQUAL_STRING("{\"topic\":\"a/b\",\"qos\":-1,\"retain\":false,\"values\":[\"x\",2,{}]}", result.c_str());
+    TEST_ASSERT_EQUAL(result.length(), json.getLength());
+}
+
+static void test_writer_escapes_strings() {
+    String result = jsonToString([](JSONWriter& json) {
+        json.value("quote\" backslash\\ newline\n control\x01");
+    });
+    TEST_ASSERT_EQUAL_STRING("\"quote\\\" backslash\\\\ newline\\n control\\u0001\"", result.c_str());
+}
+
+static void test_writer_output_is_parsed_back() {
+    String result = jsonToString([](JSONWriter& json) {
+        json.beginObject().beginObject("message").property("value", "a\"b").endObject().endObject();
+    });
+    TEST_ASSERT_EQUAL_STRING("a\"b", JSON(result).getElement("message.value").c_str());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_tokenizer_scans_all_token_types);
+    RUN_TEST(test_tokenizer_reports_position_of_string_and_number);
+    RUN_TEST(test_tokenizer_rejects_invalid_input);
+    RUN_TEST(test_tokenizer_skips_nested_values);
+    RUN_TEST(test_json_resolves_nested_paths);
+    RUN_TEST(test_json_resolves_array_indices_and_unescapes);
+    RUN_TEST(test_json_resolves_several_paths_in_one_pass);
+    RUN_TEST(test_json_get_element_to_buffer_reports_truncation);
+    RUN_TEST(test_json_ignores_malformed_documents);
+    RUN_TEST(test_json_parses_flat_object);
+    RUN_TEST(test_writer_writes_nested_containers);
+    RUN_TEST(test_writer_escapes_strings);
+    RUN_TEST(test_writer_output_is_parsed_back);
+    return UNITY_END();
+}
@@ -0,0 +1,149 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Native tests of the sorted key/value store
+ * pio test -e native
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <properties.h>
+
+void setUp() {}
+void tearDown() {}
+
+static void test_get_returns_empty_value_for_unknown_keys() {
+    Properties properties;
+    TEST_ASSERT_TRUE(properties.get("missing").isEmpty());
+    TEST_ASSERT_FALSE(properties.has("missing"));
+    TEST_ASSERT_EQUAL(0, properties.size());
+}
+
+static void test_keys_are_kept_sorted() {
+    Properties properties;
+    properties.set("wlan/ssid", "home");
+    properties.set("battery/mode", "on");
+    properties.set("battery", "x");
+    properties.set("switch/D4", "off");
+    TEST_ASSERT_EQUAL(4, properties.size());
+    TEST_ASSERT_EQUAL_STRING("battery", properties.getKey(0));
+    TEST_ASSERT_EQUAL_STRING("battery/mode", properties.getKey(1));
+    TEST_ASSERT_EQUAL_STRING("switch/D4", properties.getKey(2));
+    TEST_ASSERT_EQUAL_STRING("wlan/ssid", properties.getKey(3));
+    TEST_ASSERT_EQUAL_STRING("x", properties.get("battery").c_str());
+    TEST_ASSERT_EQUAL_STRING("on", properties.get("battery/mode").c_str());
+}
+
+static void test_get_with_length_matches_key_prefix_only_exactly() {
+    Properties properties;
+    properties.set("battery/mode", "on");
+    TEST_ASSERT_EQUAL_STRING("on", properties.get("battery/mode/ignored", 12).c_str());
+    TEST_ASSERT_TRUE(properties.get("battery/mo", 10).isEmpty());
+}
+
+static void test_set_reports_changes_and_counts_revisions() {
+    Properties properties;
+    TEST_ASSERT_TRUE(properties.set("a", "1"));
+    uint32_t revision = properties.getRevision();
+    TEST_ASSERT_FALSE(properties.set("a", "1"));
+    TEST_ASSERT_EQUAL(revision, properties.getRevision());
+    TEST_ASSERT_TRUE(properties.set("a", "2"));
+    TEST_ASSERT_EQUAL(revision + 1, properties.getRevision());
+}
+
+static void test_values_grow_shrink_and_survive_compaction() {
+    Properties properties;
+    properties.set("a", "1");
+    properties.set("b", "2");
+    for (int i = 0; i < 50; i++) {
+        String value;
+        for (int j = 0; j <= i; j++) {
+            value += char('a' + j % 26);
+        }
+        properties.set("a", value);
+        TEST_ASSERT_EQUAL_STRING(value.c_str(), properties.get("a").c_str());
+        TEST_ASSERT_EQUAL_STRING("2", properties.get("b").c_str());
+    }
+    properties.set("a", "short");
+    TEST_ASSERT_EQUAL_STRING("short", properties.get("a").c_str());
+}
+
+static void test_string_keys_are_owned() {
+    Properties properties;
+    {
+        String key("device/");
+        key += "name";
+        properties.set(key, "sensor");
+        key = "overwritten";
+    }
+    TEST_ASSERT_EQUAL_STRING("sensor", properties.get("device/name").c_str());
+}
+
+static void test_char_pointer_keys_are_owned() {
+    Properties properties;
+    {
+        char key[16];
+        strcpy(key, "device/name");
+        properties.set(key, "sensor");
+        strcpy(key, "overwritten");
+    }
+    TEST_ASSERT_EQUAL_STRING("sensor", properties.get("device/name").c_str());
+}
+
+static void test_static_keys_are_referenced() {
+    static const char key[] = "battery/mode";
+    Properties properties;
+    properties.set(StaticKey(key), "on");
+    properties.set(key, "off");
+    TEST_ASSERT_EQUAL(1, properties.size());
+    TEST_ASSERT_TRUE(properties.getKey(0) == key);
+    Properties copy(properties);
+    TEST_ASSERT_TRUE(copy.getKey(0) == key);
+    TEST_ASSERT_EQUAL_STRING("off", copy.get("battery/mode").c_str());
+}
+
+static void test_copies_are_independent() {
+    Properties properties;
+    properties.set("a", "1");
+    properties.set(String("b"), "2");
+    Properties copy(properties);
+    copy.set("a", "changed");
+    TEST_ASSERT_EQUAL_STRING("1", properties.get("a").c_str());
+    TEST_ASSERT_EQUAL_STRING("changed", copy.get("a").c_str());
+    TEST_ASSERT_EQUAL_STRING("2", copy.get("b").c_str());
+    Properties assigned;
+    assigned.set("c", "3");
+    assigned = properties;
+    TEST_ASSERT_FALSE(assigned.has("c"));
+    TEST_ASSERT_EQUAL_STRING("2", assigned.get("b").c_str());
+}
+
+static void test_property_value_conversions() {
+    Properties properties;
+    properties.set("int", "-42");
+    properties.set("float", "3.25");
+    TEST_ASSERT_EQUAL(-42, properties.get("int").toInt());
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 3.25, properties.get("float").toFloat());
+    TEST_ASSERT_TRUE(properties.get("int") == "-42");
+    TEST_ASSERT_TRUE(properties.get("int") != "42");
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_get_returns_empty_value_for_unknown_keys);
+    RUN_TEST(test_keys_are_kept_sorted);
+    RUN_TEST(test_get_with_length_matches_key_prefix_only_exactly);
+    RUN_TEST(test_set_reports_changes_and_counts_revisions);
+    RUN_TEST(test_values_grow_shrink_and_survive_compaction);
+    RUN_TEST(test_string_keys_are_owned);
+    RUN_TEST(test_char_pointer_keys_are_owned);
+    RUN_TEST(test_static_keys_are_referenced);
+    RUN_TEST(test_copies_are_independent);
+    RUN_TEST(test_property_value_conversions);
+    return UNITY_END();
+}
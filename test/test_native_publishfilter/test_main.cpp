@@ -0,0 +1,123 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Native tests of the filter suppressing unchanged values
+ * pio test -e native
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <publishfilter.h>
+
+static const uint32_t MILLISECONDS_IN_A_SECOND = 1000;
+
+static Message message(const char* topic, const char* value) {
+    return Message(topic, value);
+}
+
+/**
+ * Checks a message and delivers it, if it passes
+ * @returns true, if the message passed
+ */
+static bool publish(PublishFilter& filter, const Message& message) {
+    bool result = filter.pass(message);
+    if (result) {
+        filter.delivered(message);
+    }
+    return result;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_first_value_passes_unchanged_value_is_suppressed() {
+    PublishFilter filter;
+    TEST_ASSERT_TRUE(publish(filter, message("a/switch/D4", "on")));
+    TEST_ASSERT_FALSE(publish(filter, message("a/switch/D4", "on")));
+    TEST_ASSERT_TRUE(publish(filter, message("a/switch/D4", "off")));
+    TEST_ASSERT_TRUE(publish(filter, message("a/switch/D5", "off")));
+}
+
+static void test_deadband_suppresses_small_changes() {
+    PublishFilter filter;
+    filter.setDeadband("/temperature", 0.2);
+    TEST_ASSERT_TRUE(publish(filter, message("a/sensor/temperature", "21.00")));
+    TEST_ASSERT_FALSE(publish(filter, message("a/sensor/temperature", "21.15")));
+    TEST_ASSERT_FALSE(publish(filter, message("a/sensor/temperature", "20.85")));
+    TEST_ASSERT_TRUE(publish(filter, message("a/sensor/temperature", "21.25")));
+    // The last delivered value is the reference, not the last suppressed one
+    TEST_ASSERT_FALSE(publish(filter, message("a/sensor/temperature", "21.40")));
+}
+
+static void test_relative_deadband_needs_both_limits() {
+    PublishFilter filter;
+    filter.setDeadband("/pressure", 10, 0.01);
+    TEST_ASSERT_TRUE(publish(filter, message("a/sensor/pressure", "100000")));
+    TEST_ASSERT_FALSE(publish(filter, message("a/sensor/pressure", "100500")));
+    TEST_ASSERT_TRUE(publish(filter, message("a/sensor/pressure", "101100")));
+}
+
+static void test_silent_topics_pass_after_max_silence() {
+    PublishFilter filter;
+    filter.setMaxSilence(60);
+    TEST_ASSERT_TRUE(publish(filter, message("a/switch/D4", "on")));
+    delay(59 * MILLISECONDS_IN_A_SECOND);
+    TEST_ASSERT_FALSE(publish(filter, message("a/switch/D4", "on")));
+    delay(MILLISECONDS_IN_A_SECOND);
+    TEST_ASSERT_TRUE(publish(filter, message("a/switch/D4", "on")));
+    TEST_ASSERT_FALSE(publish(filter, message("a/switch/D4", "on")));
+}
+
+static void test_filter_keeps_order_of_passed_messages() {
+    PublishFilter filter;
+    filter.delivered(message("a/b", "1"));
+    Messages_t messages = { message("a/c", "1"), message("a/b", "1"), message("a/d", "2") };
+    Messages_t result = filter.filter(messages);
+    TEST_ASSERT_EQUAL(2, result.size());
+    TEST_ASSERT_EQUAL_STRING("a/c", result[0].getTopic().c_str());
+    TEST_ASSERT_EQUAL_STRING("a/d", result[1].getTopic().c_str());
+}
+
+static void test_clear_forgets_published_values() {
+    PublishFilter filter;
+    filter.delivered(message("a/b", "1"));
+    filter.clear();
+    TEST_ASSERT_TRUE(publish(filter, message("a/b", "1")));
+}
+
+static void test_value_is_remembered_on_delivery_only() {
+    PublishFilter filter;
+    TEST_ASSERT_TRUE(filter.pass(message("a/switch/D4", "on")));
+    TEST_ASSERT_TRUE(filter.pass(message("a/switch/D4", "on")));
+    filter.delivered(message("a/switch/D4", "on"));
+    TEST_ASSERT_FALSE(filter.pass(message("a/switch/D4", "on")));
+}
+
+static void test_topic_delivered_longest_ago_is_forgotten() {
+    PublishFilter filter;
+    for (uint8_t i = 0; i <= PublishFilter::MAX_TOPICS; i++) {
+        filter.delivered(message(("a/topic" + String(i)).c_str(), "1"));
+        delay(1);
+    }
+    TEST_ASSERT_TRUE(filter.pass(message("a/topic0", "1")));
+    TEST_ASSERT_FALSE(filter.pass(message("a/topic1", "1")));
+    TEST_ASSERT_FALSE(filter.pass(message(("a/topic" + String(PublishFilter::MAX_TOPICS)).c_str(), "1")));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_value_passes_unchanged_value_is_suppressed);
+    RUN_TEST(test_deadband_suppresses_small_changes);
+    RUN_TEST(test_relative_deadband_needs_both_limits);
+    RUN_TEST(test_silent_topics_pass_after_max_silence);
+    RUN_TEST(test_filter_keeps_order_of_passed_messages);
+    RUN_TEST(test_clear_forgets_published_values);
+    RUN_TEST(test_value_is_remembered_on_delivery_only);
+    RUN_TEST(test_topic_delivered_longest_ago_is_forgotten);
+    return UNITY_END();
+}
@@ -0,0 +1,178 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Native tests of the bounded queue of messages waiting for publishing
+ * pio test -e native
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <publishqueue.h>
+
+static Message message(int number) {
+    return Message("device/sensor/" + String(number), String(number));
+}
+
+static void push(PublishQueue& queue, int from, int to, uint8_t qos = 0, bool retain = false) {
+    for (int number = from; number <= to; number++) {
+        queue.push(message(number), qos, retain);
+    }
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_messages_are_kept_in_order() {
+    PublishQueue queue;
+    push(queue, 1, 3);
+    TEST_ASSERT_EQUAL(3, queue.size());
+    TEST_ASSERT_EQUAL_STRING("1", queue.at(0).message.getValue().c_str());
+    TEST_ASSERT_EQUAL_STRING("3", queue.at(2).message.getValue().c_str());
+    queue.pop(2);
+    TEST_ASSERT_EQUAL(1, queue.size());
+    TEST_ASSERT_EQUAL_STRING("3", queue.at(0).message.getValue().c_str());
+    queue.pop(5);
+    TEST_ASSERT_TRUE(queue.isEmpty());
+}
+
+static void test_full_queue_drops_oldest_message() {
+    PublishQueue queue(3);
+    push(queue, 1, 5);
+    TEST_ASSERT_EQUAL(3, queue.size());
+    TEST_ASSERT_EQUAL(2, queue.getDroppedAmount());
+    TEST_ASSERT_EQUAL_STRING("3", queue.at(0).message.getValue().c_str());
+    TEST_ASSERT_EQUAL_STRING("5", queue.at(2).message.getValue().c_str());
+}
+
+static void test_set_depth_drops_overflow() {
+    PublishQueue queue;
+    push(queue, 1, 5);
+    queue.setDepth(2);
+    TEST_ASSERT_EQUAL(2, queue.size());
+    TEST_ASSERT_EQUAL(3, queue.getDroppedAmount());
+    TEST_ASSERT_EQUAL_STRING("4", queue.at(0).message.getValue().c_str());
+}
+
+static void test_batch_ends_at_different_qos_or_retain() {
+    PublishQueue queue;
+    push(queue, 1, 3, 0, false);
+    push(queue, 4, 4, 1, false);
+    push(queue, 5, 5, 1, true);
+    TEST_ASSERT_EQUAL(3, queue.getBatchSize(10));
+    TEST_ASSERT_EQUAL(2, queue.getBatchSize(2));
+    queue.pop(3);
+    TEST_ASSERT_EQUAL(1, queue.getBatchSize(10));
+    queue.pop(1);
+    TEST_ASSERT_EQUAL(1, queue.getBatchSize(10));
+}
+
+static void test_failed_qos0_messages_are_dropped() {
+    PublishQueue queue;
+    push(queue, 1, 2, 0);
+    push(queue, 3, 3, 1);
+    queue.failed(2);
+    TEST_ASSERT_EQUAL(1, queue.size());
+    TEST_ASSERT_EQUAL(2, queue.getDroppedAmount());
+    TEST_ASSERT_EQUAL_STRING("3", queue.at(0).message.getValue().c_str());
+}
+
+static void test_failed_qos1_messages_are_retried_in_order() {
+    PublishQueue queue;
+    push(queue, 1, 3, 1);
+    for (uint8_t attempt = 1; attempt < PublishQueue::MAX_ATTEMPTS; attempt++) {
+        queue.failed(2);
+        TEST_ASSERT_EQUAL(3, queue.size());
+        TEST_ASSERT_EQUAL_STRING("1", queue.at(0).message.getValue().c_str());
+        TEST_ASSERT_EQUAL_STRING("2", queue.at(1).message.getValue().c_str());
+        TEST_ASSERT_EQUAL(attempt, queue.at(0).attempts);
+    }
+    queue.failed(2);
+    TEST_ASSERT_EQUAL(1, queue.size());
+    TEST_ASSERT_EQUAL(2, queue.getDroppedAmount());
+    TEST_ASSERT_EQUAL_STRING("3", queue.at(0).message.getValue().c_str());
+}
+
+static void test_push_while_in_flight_keeps_sent_messages() {
+    PublishQueue queue(3);
+    push(queue, 1, 3);
+    queue.setInFlight(2);
+    push(queue, 4, 5);
+    TEST_ASSERT_EQUAL(3, queue.size());
+    TEST_ASSERT_EQUAL(2, queue.getDroppedAmount());
+    TEST_ASSERT_EQUAL_STRING("1", queue.at(0).message.getValue().c_str());
+    TEST_ASSERT_EQUAL_STRING("2", queue.at(1).message.getValue().c_str());
+    TEST_ASSERT_EQUAL_STRING("5", queue.at(2).message.getValue().c_str());
+    queue.pop(queue.getInFlight());
+    TEST_ASSERT_EQUAL(0, queue.getInFlight());
+    TEST_ASSERT_EQUAL(1, queue.size());
+    TEST_ASSERT_EQUAL_STRING("5", queue.at(0).message.getValue().c_str());
+}
+
+static void test_push_drops_new_message_if_all_are_in_flight() {
+    PublishQueue queue(2);
+    push(queue, 1, 2);
+    queue.setInFlight(2);
+    push(queue, 3, 3);
+    TEST_ASSERT_EQUAL(2, queue.size());
+    TEST_ASSERT_EQUAL(1, queue.getDroppedAmount());
+    TEST_ASSERT_EQUAL_STRING("1", queue.at(0).message.getValue().c_str());
+    TEST_ASSERT_EQUAL_STRING("2", queue.at(1).message.getValue().c_str());
+}
+
+static void test_set_depth_keeps_messages_in_flight() {
+    PublishQueue queue;
+    push(queue, 1, 5);
+    queue.setInFlight(3);
+    queue.setDepth(2);
+    TEST_ASSERT_EQUAL(3, queue.size());
+    TEST_ASSERT_EQUAL(2, queue.getDroppedAmount());
+    TEST_ASSERT_EQUAL_STRING("3", queue.at(2).message.getValue().c_str());
+}
+
+static void test_failed_messages_in_flight_are_retried_before_new_ones() {
+    PublishQueue queue(3);
+    push(queue, 1, 2, 1);
+    queue.setInFlight(2);
+    push(queue, 3, 4, 1);
+    queue.failed(queue.getInFlight());
+    TEST_ASSERT_EQUAL(0, queue.getInFlight());
+    TEST_ASSERT_EQUAL(3, queue.size());
+    TEST_ASSERT_EQUAL_STRING("1", queue.at(0).message.getValue().c_str());
+    TEST_ASSERT_EQUAL_STRING("2", queue.at(1).message.getValue().c_str());
+    TEST_ASSERT_EQUAL_STRING("4", queue.at(2).message.getValue().c_str());
+    // Without messages in flight the oldest message is dropped again
+    push(queue, 5, 5, 1);
+    TEST_ASSERT_EQUAL_STRING("2", queue.at(0).message.getValue().c_str());
+}
+
+static void test_pop_reports_delivered_messages() {
+    PublishQueue queue;
+    String delivered;
+    queue.setDeliveredFunction([&delivered](const Message& message) { delivered += message.getValue(); });
+    push(queue, 1, 4, 1);
+    queue.failed(1);
+    TEST_ASSERT_EQUAL_STRING("", delivered.c_str());
+    queue.pop(2);
+    TEST_ASSERT_EQUAL_STRING("12", delivered.c_str());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_messages_are_kept_in_order);
+    RUN_TEST(test_full_queue_drops_oldest_message);
+    RUN_TEST(test_set_depth_drops_overflow);
+    RUN_TEST(test_batch_ends_at_different_qos_or_retain);
+    RUN_TEST(test_failed_qos0_messages_are_dropped);
+    RUN_TEST(test_failed_qos1_messages_are_retried_in_order);
+    RUN_TEST(test_push_while_in_flight_keeps_sent_messages);
+    RUN_TEST(test_push_drops_new_message_if_all_are_in_flight);
+    RUN_TEST(test_set_depth_keeps_messages_in_flight);
+    RUN_TEST(test_failed_messages_in_flight_are_retried_before_new_ones);
+    RUN_TEST(test_pop_reports_delivered_messages);
+    return UNITY_END();
+}
@@ -0,0 +1,161 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Native tests of the sample buffer in RTC memory, every buffer instance simulates one wake.
+ * The clock is not advanced, the sample ages only consist of the stored sleep times.
+ * pio test -e native
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <rtcmem.h>
+#include <json.h>
+#include <samplebuffer.h>
+
+static const uint8_t UPLOAD_INTERVAL = 4;
+static const uint16_t SLEEP_TIME = 600;
+
+/**
+ * Simulates a wake, passes the sensor values and stores the sample before the next deep sleep
+ * @returns true, if the wake was a sampling wake
+ */
+static bool wake(const char* temperature, const char* humidity, bool isUploaded = false) {
+    SampleBuffer buffer;
+    buffer.setUploadInterval(UPLOAD_INTERVAL);
+    bool result = buffer.isSamplingWake();
+    buffer.handleMessage("sensor/temperature", temperature);
+    buffer.handleMessage("sensor/humidity", humidity);
+    buffer.store(SLEEP_TIME, isUploaded && !result);
+    ESP.getResetInfoPtr()->reason = REASON_DEEP_SLEEP_AWAKE;
+    return result;
+}
+
+static Messages_t getMessages() {
+    SampleBuffer buffer;
+    buffer.setUploadInterval(UPLOAD_INTERVAL);
+    return buffer.getMessages("area/device");
+}
+
+void setUp() {
+    for (uint16_t block = RTC_SAMPLE_BLOCK; block < RTC_FREE_BLOCK; block++) {
+        RTCMem<uint32_t>::write(block, 0);
+    }
+    ESP.getResetInfoPtr()->reason = REASON_DEFAULT_RST;
+}
+
+void tearDown() {}
+
+static void test_disabled_buffer_never_samples() {
+    SampleBuffer buffer;
+    buffer.setUploadInterval(1);
+    ESP.getResetInfoPtr()->reason = REASON_DEEP_SLEEP_AWAKE;
+    TEST_ASSERT_FALSE(buffer.isEnabled());
+    TEST_ASSERT_FALSE(buffer.isSamplingWake());
+    buffer.handleMessage("sensor/temperature", "21.00");
+    buffer.store(SLEEP_TIME, false);
+    TEST_ASSERT_FALSE(buffer.isNextSampling());
+    TEST_ASSERT_EQUAL(0, buffer.getMessages("area/device").size());
+}
+
+static void test_power_on_is_no_sampling_wake() {
+    TEST_ASSERT_FALSE(wake("21.00", "50.00", true));
+    SampleBuffer buffer;
+    buffer.setUploadInterval(UPLOAD_INTERVAL);
+    TEST_ASSERT_TRUE(buffer.isNextSampling());
+}
+
+static void test_every_upload_interval_wake_uses_the_radio() {
+    TEST_ASSERT_FALSE(wake("21.00", "50.00", true));
+    for (uint8_t round = 0; round < 2; round++) {
+        for (uint8_t i = 1; i < UPLOAD_INTERVAL; i++) {
+            TEST_ASSERT_TRUE(wake("21.00", "50.00"));
+        }
+        TEST_ASSERT_FALSE(wake("21.00", "50.00", true));
+    }
+}
+
+static void test_samples_are_uploaded_newest_first_with_age() {
+    wake("21.00", "50.00", true);
+    wake("21.10", "50.10");
+    wake("21.20", "50.20");
+    wake("21.30", "50.30");
+    Messages_t messages = getMessages();
+    TEST_ASSERT_EQUAL(1, messages.size());
+    TEST_ASSERT_EQUAL_STRING("area/device/sensor/samples", messages[0].getTopic().c_str());
+    JSON json(messages[0].getValue());
+    TEST_ASSERT_EQUAL_STRING("600", json.getElement("[0].ageInSeconds").c_str());
+    TEST_ASSERT_EQUAL_STRING("21.30", json.getElement("[0].temperature").c_str());
+    TEST_ASSERT_EQUAL_STRING("50.30", json.getElement("[0].humidity").c_str());
+    TEST_ASSERT_EQUAL_STRING("1800", json.getElement("[2].ageInSeconds").c_str());
+    TEST_ASSERT_EQUAL_STRING("21.10", json.getElement("[2].temperature").c_str());
+    JSONSpan span;
+    TEST_ASSERT_FALSE(json.findElement("[3]", span));
+    TEST_ASSERT_FALSE(json.findElement("[0].pressure", span));
+}
+
+static void test_upload_clears_the_buffer() {
+    wake("21.00", "50.00", true);
+    wake("21.10", "50.00");
+    wake("21.10", "50.00");
+    wake("21.10", "50.00");
+    TEST_ASSERT_EQUAL(1, getMessages().size());
+    wake("21.10", "50.00", true);
+    TEST_ASSERT_EQUAL(0, getMessages().size());
+}
+
+static void test_failed_upload_keeps_the_samples() {
+    wake("21.00", "50.00", true);
+    for (uint8_t i = 1; i < UPLOAD_INTERVAL; i++) {
+        wake("21.00", "50.00");
+    }
+    // The radio wake failing to upload stores its sample too and stays a radio wake
+    TEST_ASSERT_FALSE(wake("21.00", "50.00", false));
+    Messages_t messages = getMessages();
+    TEST_ASSERT_EQUAL(1, messages.size());
+    JSON json(messages[0].getValue());
+    JSONSpan span;
+    TEST_ASSERT_TRUE(json.findElement("[3]", span));
+    TEST_ASSERT_FALSE(json.findElement("[4]", span));
+    TEST_ASSERT_FALSE(wake("21.00", "50.00", true));
+    TEST_ASSERT_EQUAL(0, getMessages().size());
+}
+
+static void test_threshold_ends_sampling_at_once() {
+    wake("21.00", "50.00", true);
+    TEST_ASSERT_TRUE(wake("21.50", "50.00"));
+    SampleBuffer buffer;
+    buffer.setUploadInterval(UPLOAD_INTERVAL);
+    TEST_ASSERT_TRUE(buffer.isSamplingWake());
+    buffer.handleMessage("sensor/temperature", "22.00");
+    TEST_ASSERT_FALSE(buffer.isSamplingWake());
+    buffer.store(0, false);
+    TEST_ASSERT_FALSE(buffer.isNextSampling());
+}
+
+static void test_humidity_threshold_is_checked() {
+    wake("21.00", "50.00", true);
+    SampleBuffer buffer;
+    buffer.setUploadInterval(UPLOAD_INTERVAL);
+    buffer.handleMessage("sensor/humidity", "54.90");
+    TEST_ASSERT_TRUE(buffer.isSamplingWake());
+    buffer.handleMessage("sensor/humidity", "55.00");
+    TEST_ASSERT_FALSE(buffer.isSamplingWake());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_disabled_buffer_never_samples);
+    RUN_TEST(test_power_on_is_no_sampling_wake);
+    RUN_TEST(test_every_upload_interval_wake_uses_the_radio);
+    RUN_TEST(test_samples_are_uploaded_newest_first_with_age);
+    RUN_TEST(test_upload_clears_the_buffer);
+    RUN_TEST(test_failed_upload_keeps_the_samples);
+    RUN_TEST(test_threshold_ends_sampling_at_once);
+    RUN_TEST(test_humidity_threshold_is_checked);
+    return UNITY_END();
+}
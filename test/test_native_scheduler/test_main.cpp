@@ -0,0 +1,109 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Native tests of the cooperative scheduler, delay advances the simulated clock
+ * pio test -e native
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <vector>
+#include <scheduler.h>
+
+void setUp() {
+    Scheduler::getStatistic(true);
+}
+
+void tearDown() {
+    Scheduler::clear();
+    Scheduler::setIdleFunction(nullptr);
+    Scheduler::setSleepFunctions(nullptr, nullptr);
+    Scheduler::setIdleInterval(Scheduler::DEFAULT_IDLE_INTERVAL);
+}
+
+static void test_tasks_run_at_their_interval() {
+    uint32_t start = millis();
+    std::vector<uint32_t> times;
+    Scheduler::addTask([&times, start]() { times.push_back(millis() - start); }, 100);
+    Scheduler::runFor(1000);
+    TEST_ASSERT_EQUAL(10, times.size());
+    for (uint8_t i = 0; i < times.size(); i++) {
+        TEST_ASSERT_EQUAL(i * 100, times[i]);
+    }
+    TEST_ASSERT_EQUAL(start + 1000, millis());
+}
+
+static void test_first_run_is_delayed() {
+    uint32_t start = millis();
+    std::vector<uint32_t> times;
+    Scheduler::addTask([&times, start]() { times.push_back(millis() - start); }, 100, 50);
+    Scheduler::runFor(300);
+    TEST_ASSERT_EQUAL(3, times.size());
+    TEST_ASSERT_EQUAL(50, times[0]);
+    TEST_ASSERT_EQUAL(250, times[2]);
+}
+
+static void test_missed_periods_are_skipped() {
+    uint32_t start = millis();
+    std::vector<uint32_t> times;
+    Scheduler::addTask([&times, start]() { times.push_back(millis() - start); }, 100);
+    Scheduler::addTask([]() { delay(350); }, 10000, 120);
+    Scheduler::runFor(1000);
+    const uint32_t expected[] = { 0, 100, 470, 570, 670, 770, 870, 970 };
+    TEST_ASSERT_EQUAL(sizeof(expected) / sizeof(expected[0]), times.size());
+    for (uint8_t i = 0; i < times.size(); i++) {
+        TEST_ASSERT_EQUAL(expected[i], times[i]);
+    }
+}
+
+static void test_idle_time_is_slept_in_idle_intervals() {
+    uint32_t idleAmount = 0;
+    Scheduler::setIdleInterval(25);
+    Scheduler::setIdleFunction([&idleAmount]() { idleAmount++; });
+    Scheduler::runFor(100);
+    Scheduler::Statistic statistic = Scheduler::getStatistic(true);
+    TEST_ASSERT_EQUAL(100, statistic.time);
+    TEST_ASSERT_EQUAL(100, statistic.sleepTime);
+    TEST_ASSERT_EQUAL(4, statistic.wakeups);
+    TEST_ASSERT_EQUAL(4, idleAmount);
+    statistic = Scheduler::getStatistic();
+    TEST_ASSERT_EQUAL(0, statistic.time);
+    TEST_ASSERT_EQUAL(0, statistic.wakeups);
+}
+
+static void test_sleep_ends_at_next_due_task() {
+    uint32_t runAmount = 0;
+    Scheduler::setIdleInterval(1000);
+    Scheduler::addTask([&runAmount]() { runAmount++; }, 30);
+    Scheduler::runFor(90);
+    Scheduler::Statistic statistic = Scheduler::getStatistic();
+    TEST_ASSERT_EQUAL(3, runAmount);
+    TEST_ASSERT_EQUAL(90, statistic.sleepTime);
+    TEST_ASSERT_EQUAL(3, statistic.wakeups);
+}
+
+static void test_sleep_functions_enclose_every_sleep() {
+    String events;
+    Scheduler::setIdleInterval(1000);
+    Scheduler::addTask([&events]() { events += "t"; }, 30);
+    Scheduler::setSleepFunctions([&events]() { events += "("; }, [&events]() { events += ")"; });
+    Scheduler::runFor(90);
+    TEST_ASSERT_EQUAL_STRING("t()t()t()", events.c_str());
+    TEST_ASSERT_EQUAL(3, Scheduler::getStatistic().wakeups);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_tasks_run_at_their_interval);
+    RUN_TEST(test_first_run_is_delayed);
+    RUN_TEST(test_missed_periods_are_skipped);
+    RUN_TEST(test_idle_time_is_slept_in_idle_intervals);
+    RUN_TEST(test_sleep_ends_at_next_due_task);
+    RUN_TEST(test_sleep_functions_enclose_every_sleep);
+    return UNITY_END();
+}
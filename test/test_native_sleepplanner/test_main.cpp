@@ -0,0 +1,136 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Native tests of the sleep time adaption, every planner instance simulates one wake
+ * pio test -e native
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <rtcmem.h>
+#include <sleepplanner.h>
+
+static const uint16_t BASE_TIME = 600;
+
+static SleepPlanner::Reading reading(float voltage, float temperature, float humidity) {
+    SleepPlanner::Reading result;
+    result.voltage = voltage;
+    result.temperature = temperature;
+    result.humidity = humidity;
+    result.hasClimate = true;
+    return result;
+}
+
+/**
+ * Plans and stores the sleep time of one wake
+ */
+static uint16_t wake(const SleepPlanner::Reading& reading, uint16_t minTime = 60, uint16_t maxTime = 0) {
+    SleepPlanner planner;
+    uint16_t result = planner.getSleepTimeInSeconds(BASE_TIME, minTime, maxTime, reading);
+    planner.store(reading, result);
+    return result;
+}
+
+void setUp() {
+    for (uint16_t block = RTC_SLEEP_BLOCK; block < RTC_SAMPLE_BLOCK; block++) {
+        RTCMem<uint32_t>::write(block, 0);
+    }
+}
+
+void tearDown() {}
+
+static void test_base_time_without_history() {
+    TEST_ASSERT_EQUAL(BASE_TIME, wake(reading(3.3, 21, 50)));
+}
+
+static void test_stable_readings_raise_the_sleep_time() {
+    wake(reading(3.3, 21, 50));
+    TEST_ASSERT_EQUAL(750, wake(reading(3.3, 21, 50)));
+    TEST_ASSERT_EQUAL(937, wake(reading(3.3, 21.01, 50)));
+}
+
+static void test_fast_changes_halve_the_sleep_time() {
+    wake(reading(3.3, 21, 50));
+    TEST_ASSERT_EQUAL(300, wake(reading(3.3, 22, 50)));
+    TEST_ASSERT_EQUAL(150, wake(reading(3.3, 22, 55)));
+}
+
+static void test_medium_changes_keep_the_sleep_time() {
+    wake(reading(3.3, 21, 50));
+    TEST_ASSERT_EQUAL(BASE_TIME, wake(reading(3.3, 21.1, 50)));
+}
+
+static void test_sleep_time_stays_within_bounds() {
+    wake(reading(3.3, 21, 50));
+    for (uint8_t i = 0; i < 20; i++) {
+        TEST_ASSERT_LESS_OR_EQUAL(800, wake(reading(3.3, 21, 50), 60, 800));
+    }
+    // The factor is limited to the bound (800 s), the next change halves it at once
+    TEST_ASSERT_EQUAL(393, wake(reading(3.3, 25, 50), 60, 800));
+    for (uint8_t i = 0; i < 10; i++) {
+        wake(reading(3.3, 20 + (i % 2) * 5, 50), 120);
+    }
+    TEST_ASSERT_EQUAL(120, wake(reading(3.3, 20, 50), 120));
+}
+
+static void test_falling_voltage_doubles_stable_sleep_time() {
+    wake(reading(3.30, 21, 50));
+    wake(reading(3.29, 21, 50));
+    wake(reading(3.28, 21, 50));
+    SleepPlanner planner;
+    // The factor of the last wake (937 s) is doubled instead of raised by a quarter
+    TEST_ASSERT_EQUAL(1856, planner.getSleepTimeInSeconds(BASE_TIME, 60, 0, reading(3.27, 21, 50)));
+}
+
+static SleepPlanner::Reading voltageReading(float voltage) {
+    SleepPlanner::Reading result;
+    result.voltage = voltage;
+    return result;
+}
+
+static void test_history_without_climate_keeps_factor() {
+    wake(voltageReading(3.3));
+    TEST_ASSERT_EQUAL(BASE_TIME, wake(voltageReading(3.3)));
+}
+
+static void test_voltage_only_readings_do_not_drift_to_max() {
+    for (uint8_t i = 0; i < 20; i++) {
+        TEST_ASSERT_EQUAL(BASE_TIME, wake(voltageReading(3.3), 60, 3600));
+    }
+}
+
+static void test_falling_voltage_without_climate_doubles_base_time_once() {
+    uint16_t sleepTime = 0;
+    for (uint8_t i = 0; i < 20; i++) {
+        sleepTime = wake(voltageReading(3.3 - i * 0.01), 60, 3600);
+        TEST_ASSERT_TRUE(sleepTime == BASE_TIME || sleepTime == 2 * BASE_TIME);
+    }
+    TEST_ASSERT_EQUAL(2 * BASE_TIME, sleepTime);
+}
+
+static void test_invalid_rtc_memory_is_reset() {
+    wake(reading(3.3, 21, 50));
+    wake(reading(3.3, 21, 50));
+    RTCMem<uint32_t>::write(RTC_SLEEP_BLOCK, 0xDEADBEEF);
+    TEST_ASSERT_EQUAL(BASE_TIME, wake(reading(3.3, 21, 50)));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_base_time_without_history);
+    RUN_TEST(test_stable_readings_raise_the_sleep_time);
+    RUN_TEST(test_fast_changes_halve_the_sleep_time);
+    RUN_TEST(test_medium_changes_keep_the_sleep_time);
+    RUN_TEST(test_sleep_time_stays_within_bounds);
+    RUN_TEST(test_falling_voltage_doubles_stable_sleep_time);
+    RUN_TEST(test_history_without_climate_keeps_factor);
+    RUN_TEST(test_voltage_only_readings_do_not_drift_to_max);
+    RUN_TEST(test_falling_voltage_without_climate_doubles_base_time_once);
+    RUN_TEST(test_invalid_rtc_memory_is_reset);
+    return UNITY_END();
+}
@@ -0,0 +1,156 @@
+/**
+ * This software is licensed under the GNU LESSER GENERAL PUBLIC LICENSE Version 3. It is furnished
+ * "as is", without any support, and with no warranty, express or implied, as to its usefulness for
+ * any purpose.
+ *
+ * @author Volker Böhm
+ * @copyright Copyright (c) 2020 Volker Böhm
+ * @brief
+ * Native tests of the wake cycle of a battery powered device
+ * pio test -e native
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <loopback.h>
+#include <json.h>
+#include <eepromaccess.h>
+#include <battery.h>
+#include <yahaserver.h>
+
+static const uint8_t UPLOAD_INTERVAL = 4;
+
+// Created in main, the device list of the server is a static of another translation unit
+static YahaServer* server;
+static Battery battery;
+static int publishStatusCode = 200;
+
+/**
+ * Answers the broker requests, publish requests with publishStatusCode
+ */
+static int handleBrokerRequest(const String& method, const String& uri, const Loopback::headers_t& headers,
+    const String& body, String& response) 
+{
+    if (uri.startsWith("/publish")) {
+        return publishStatusCode;
+    }
+    response = "{\"token\":{\"send\":\"s\",\"receive\":\"r\"}}";
+    return 200;
+}
+
+/**
+ * Stores the configuration of a device in battery mode to EEPROM
+ */
+static void configure() {
+    Properties config = battery.getConfig();
+    config.set(YahaServer::wlan.getConfig());
+    config.set("wlan/ssid", "home");
+    config.set("battery/mode", "on");
+    YahaServer::updateConfig(config);
+}
+
+/**
+ * Simulates a wake after deep sleep
+ */
+static void wake() {
+    ESP.getResetInfoPtr()->reason = REASON_DEEP_SLEEP_AWAKE;
+    server->setup("test");
+    server->loop();
+}
+
+/**
+ * @returns amount of samples waiting for upload
+ */
+static uint8_t getSampleAmount() {
+    SampleBuffer buffer;
+    buffer.setUploadInterval(UPLOAD_INTERVAL);
+    Messages_t messages = buffer.getMessages("area/device");
+    if (messages.empty()) {
+        return 0;
+    }
+    JSON json(messages[0].getValue());
+    JSONSpan span;
+    uint8_t result = 0;
+    while (json.findElement(("[" + String(result) + "]").c_str(), span)) {
+        result++;
+    }
+    return result;
+}
+
+/**
+ * Runs the sampling wakes up to the next radio wake
+ */
+static void sampleUntilUpload() {
+    YahaServer::sampleBuffer.store(600, true);
+    for (uint8_t i = 1; i < UPLOAD_INTERVAL; i++) {
+        wake();
+    }
+    TEST_ASSERT_FALSE(YahaServer::sampleBuffer.isNextSampling());
+}
+
+void setUp() {
+    Loopback::resetStatistics();
+    publishStatusCode = 200;
+}
+
+void tearDown() {}
+
+static void test_sampling_wake_stores_sample_without_radio() {
+    YahaServer::sampleBuffer.store(600, true);
+    wake();
+    TEST_ASSERT_EQUAL(WL_DISCONNECTED, WiFi.status());
+    TEST_ASSERT_EQUAL(0, Loopback::getConnectAmount());
+    TEST_ASSERT_EQUAL(1, getSampleAmount());
+    TEST_ASSERT_TRUE(YahaServer::sampleBuffer.isNextSampling());
+    SampleBuffer buffer;
+    buffer.setUploadInterval(UPLOAD_INTERVAL);
+    TEST_ASSERT_TRUE(buffer.getMessages("area/device")[0].getValue().indexOf("\"voltage\"") > 0);
+}
+
+static void test_radio_wake_uploads_samples() {
+    sampleUntilUpload();
+    TEST_ASSERT_EQUAL(UPLOAD_INTERVAL - 1, getSampleAmount());
+    wake();
+    TEST_ASSERT_TRUE(Loopback::getConnectAmount() > 0);
+    TEST_ASSERT_TRUE(YahaServer::brokerProxy.isFlushed());
+    TEST_ASSERT_EQUAL(0, getSampleAmount());
+    TEST_ASSERT_TRUE(YahaServer::sampleBuffer.isNextSampling());
+}
+
+static void test_samples_are_kept_if_broker_rejects_them() {
+    sampleUntilUpload();
+    publishStatusCode = 500;
+    wake();
+    TEST_ASSERT_TRUE(Loopback::getRequestAmount() > 0);
+    TEST_ASSERT_FALSE(YahaServer::brokerProxy.isFlushed());
+    TEST_ASSERT_EQUAL(UPLOAD_INTERVAL, getSampleAmount());
+    TEST_ASSERT_FALSE(YahaServer::sampleBuffer.isNextSampling());
+}
+
+static void test_fresh_device_keeps_config_of_other_pages() {
+    const uint8_t erased[EEPROMAccess::EEPROM_SIZE] = { 0 };
+    EEPROMAccess::write(0, erased, sizeof(erased));
+    YahaServer::setupEEPROM();
+    TEST_ASSERT_FALSE(YahaServer::wlan.isInitialized());
+    Properties config = battery.getConfig();
+    config.set("battery/lowVoltageSleepTimeInSeconds", "1234");
+    YahaServer::updateConfig(config);
+    YahaServer::setupEEPROM();
+    TEST_ASSERT_TRUE(YahaServer::wlan.isInitialized());
+    TEST_ASSERT_EQUAL(1234, battery.getConfig().get("battery/lowVoltageSleepTimeInSeconds").toInt());
+    configure();
+}
+
+int main(int argc, char** argv) {
+    Loopback::setHandler(handleBrokerRequest);
+    server = new YahaServer();
+    server->addDevice(&battery);
+    server->enableSampling(UPLOAD_INTERVAL);
+    configure();
+    UNITY_BEGIN();
+    RUN_TEST(test_sampling_wake_stores_sample_without_radio);
+    RUN_TEST(test_radio_wake_uploads_samples);
+    RUN_TEST(test_samples_are_kept_if_broker_rejects_them);
+    RUN_TEST(test_fresh_device_keeps_config_of_other_pages);
+    return UNITY_END();
+}